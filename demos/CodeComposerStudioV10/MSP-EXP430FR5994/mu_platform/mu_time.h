@@ -26,7 +26,7 @@
 #define _MU_TIME_H_
 
 #ifdef __cplusplus
-extern "C";
+extern "C" {
 #endif
 
 // =============================================================================
@@ -42,7 +42,21 @@ extern "C";
 #define RTC_FREQUENCY 32768L
 #define MS_PER_SECOND 1000L
 
-#define MU_TIME_MS_TO_DURATION(ms) ((mu_duration_t)((ms * RTC_FREQUENCY) / MS_PER_SECOND))
+/**
+ * Tick <-> millisecond conversions are (x * MUL) >> SHIFT.  See "Tick and
+ * millisecond conversions" in docs/porting_mulib.md for how SHIFT is chosen.
+ * At 32768 Hz:
+ *
+ * - ticks to ms is exact: 1000 / 32768 = 125 / 4096, so MUL is 125.
+ * - ms to ticks is exact for |ms| < 1198372 (about 20 minutes).  Beyond that
+ *   it is at most 1 tick long, up to the largest ms whose tick count fits in
+ *   a mu_duration_t (about 18 hours).
+ */
+#define MU_TIME_TICKS_TO_MS_SHIFT 12
+#define MU_TIME_MS_TO_TICKS_SHIFT 26
+
+#define MU_TIME_FREQUENCY RTC_FREQUENCY
+#include "../../../shared/mu_time_scale/mu_time_scale.h"
 
 // =============================================================================
 // declarations
@@ -121,15 +135,15 @@ bool mu_time_equals(mu_time_t t1, mu_time_t t2);
 bool mu_time_follows(mu_time_t t1, mu_time_t t2);
 
 /**
- * @brief Convert a duration to milliseconds.
+ * @brief Convert a duration to milliseconds, truncating toward zero.
  *
  * @param dt A duration object
- * @return The duration in seconds
+ * @return The duration in milliseconds
  */
 mu_duration_ms_t mu_time_duration_to_ms(mu_duration_t dt);
 
 /**
- * @brief Convert milliseconds to a duration
+ * @brief Convert milliseconds to a duration, truncating toward zero.
  *
  * @param ms The duration in milliseconds
  * @return A duration object
@@ -26,7 +26,7 @@
 #define _MU_TIME_H_
 
 #ifdef __cplusplus
-extern "C";
+extern "C" {
 #endif
 
 // =============================================================================
@@ -45,7 +45,17 @@ extern "C";
   #error "Provide a platform-specific definition for SYSTICK_FREQUENCY"
 #endif
 
-#define MU_TIME_MS_TO_DURATION(ms) (((ms) * 1000) / SYSTICK_FREQUENCY)
+/**
+ * Tick <-> millisecond conversions are (x * MUL) >> SHIFT.  See "Tick and
+ * millisecond conversions" in docs/porting_mulib.md for how SHIFT is chosen.
+ * At 1000 Hz both conversions are exact with a SHIFT of 0, and the compiler
+ * reduces them to nothing.
+ */
+#define MU_TIME_TICKS_TO_MS_SHIFT 0
+#define MU_TIME_MS_TO_TICKS_SHIFT 0
+
+#define MU_TIME_FREQUENCY SYSTICK_FREQUENCY
+#include "../../../shared/mu_time_scale/mu_time_scale.h"
 
 // =============================================================================
 // declarations
@@ -119,15 +129,15 @@ bool mu_time_equals(mu_time_t t1, mu_time_t t2);
 bool mu_time_follows(mu_time_t t1, mu_time_t t2);
 
 /**
- * @brief Convert a duration to milliseconds.
+ * @brief Convert a duration to milliseconds, truncating toward zero.
  *
  * @param dt A duration object
- * @return The duration in seconds
+ * @return The duration in milliseconds
  */
 mu_duration_ms_t mu_time_duration_to_ms(mu_duration_t dt);
 
 /**
- * @brief Convert milliseconds to a duration
+ * @brief Convert milliseconds to a duration, truncating toward zero.
  *
  * @param ms The duration in milliseconds
  * @return A duration object
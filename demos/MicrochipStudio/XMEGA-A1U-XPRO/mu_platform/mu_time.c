@@ -102,23 +102,24 @@ bool mu_time_follows(mu_time_t t1, mu_time_t t2) {
 }
 
 /**
- * @brief Convert a duration to milliseconds.
+ * @brief Convert a duration to milliseconds, truncating toward zero.
  *
  * @param dt A duration object
- * @return The duration in seconds
+ * @return The duration in milliseconds
  */
 mu_duration_ms_t mu_time_duration_to_ms(mu_duration_t dt) {
-  return (dt * 1000) / RTC_FREQUENCY;
+  return (mu_duration_ms_t)MU_TIME_SCALE_SIGNED(
+      dt, MU_TIME_TICKS_TO_MS_MUL, MU_TIME_TICKS_TO_MS_SHIFT);
 }
 
 /**
- * @brief Convert milliseconds to a duration
+ * @brief Convert milliseconds to a duration, truncating toward zero.
  *
  * @param ms The duration in milliseconds
  * @return A duration object
  */
 mu_duration_t mu_time_ms_to_duration(mu_duration_ms_t ms) {
-  return (ms * RTC_FREQUENCY) / 1000;
+  return MU_TIME_MS_TO_DURATION(ms);
 }
 
 #ifdef MU_FLOAT
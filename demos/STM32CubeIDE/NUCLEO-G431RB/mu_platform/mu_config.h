@@ -38,8 +38,8 @@ extern "C" {
 // =============================================================================
 // types and definitions
 
-#define MU_DISABLE_INTERRUPTS() __disable_irq
-#define MU_ENABLE_INTERRUPTS() __enable_irq
+#define MU_DISABLE_INTERRUPTS() __disable_irq()
+#define MU_ENABLE_INTERRUPTS() __enable_irq()
 
 /**
  * Uncomment if you want logging enabled.
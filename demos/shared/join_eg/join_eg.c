@@ -109,8 +109,6 @@ static void task_fn(void *ctx, void *arg) {
   start_sleeper(&s_sleeper_b, "Sleeper B", at);
   at = mu_time_offset(now, mu_time_ms_to_duration(random_range(MIN_MS, MAX_MS)));
   start_sleeper(&s_sleeper_c, "Sleeper C", at);
-
-  ctx->sleepers_are_iniitalied = true;
 }
 
 static void start_sleeper(sleeper_ctx_t *sleeper,
@@ -39,10 +39,6 @@
 
 static void task_fn(void *ctx, void *arg);
 
-static void timeout_task_fn(void *ctx, void *arg);
-
-static void endgame(joiner_wto_ctx_t *self, void *arg, const char *cause);
-
 // =============================================================================
 // Local storage
 
@@ -54,13 +50,18 @@ mu_task_t *joiner_init(joiner_ctx_t *ctx, mu_task_t *on_completion) {
   mu_task_init(&ctx->task, task_fn, ctx, "Joiner");
   ctx->on_completion = on_completion;
   ctx->pending_count = 0;
+  mu_signal_init(&ctx->done, &ctx->task);
 
   return &ctx->task;
 }
 
-mu_task_t *joiner_add_task(joiner_ctx_t *ctx) {
+joiner_ctx_t *joiner_add_task(joiner_ctx_t *ctx) {
   ctx->pending_count += 1;
-  return &ctx->task;
+  return ctx;
+}
+
+void joiner_notify(joiner_ctx_t *ctx) {
+  mu_signal_post(&ctx->done);
 }
 
 // =============================================================================
@@ -70,9 +71,12 @@ static void task_fn(void *ctx, void *arg) {
   joiner_ctx_t *self = (joiner_ctx_t *)ctx;
   (void)arg;  // unused
 
-  self->pending_count -= 1;
-
-  mu_stddemo_printf("Task completed, pending count = %d\n", self->pending_count);
+  // consume every completion posted since the joiner last ran
+  int completed = mu_signal_take(&self->done);
+  self->pending_count -= completed;
+  mu_stddemo_printf("%d task(s) completed, pending count = %d\n",
+                    completed,
+                    self->pending_count);
 
   if (self->pending_count == 0) {
     mu_stddemo_led_set(false);  // turn off LED when all sleepers complete
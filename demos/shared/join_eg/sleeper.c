@@ -48,11 +48,11 @@ static void task_fn(void *ctx, void *arg);
 
 mu_task_t *sleeper_init(sleeper_ctx_t *ctx,
                         const char *name,
-                        mu_task_t *on_completion) {
+                        joiner_ctx_t *joiner) {
   // initialize the mu_task to associate task_fn with the sleeper_ctx
   mu_task_init(&ctx->task, task_fn, ctx, name);
   ctx->name = name;
-  ctx->on_completion = on_completion;
+  ctx->joiner = joiner;
 
   return &ctx->task;
 }
@@ -71,20 +71,14 @@ static void task_fn(void *ctx, void *arg) {
 
   mu_stddemo_led_set(true);  // turn on LED when any sleeper wakes
   mu_stddemo_printf("%s waking at %ld tics\n", self->name, mu_time_now());
-  if (self->on_completion != NULL) {
-    // Subtle bug: It two Sleepers wake up at the same time (or nearly at the
-    // same time), the first call to mu_sched_task_now(joiner) will schedule a
-    // call the the Joiner.  But before the Joiner task runs, the second call
-    // to mu_sched_task_now(joiner) will remove it from the schedule, so misses
-    // a call, its reference count never get to zero and the process hangs.
-    //
-    // So don't do this:
-    //
-    // mu_sched_task_now(self->on_completion);
-    //
-    // The fix is to circumvent the scheduler, and have the Sleeper task invoke
-    // the Joiner task directly, like this:
-    mu_task_call(self->on_completion, NULL);
+  if (self->joiner != NULL) {
+    // Don't call mu_sched_task_now() on the joiner's task directly: if two
+    // sleepers wake at (nearly) the same time, the second call simply moves
+    // the already-scheduled joiner and one wakeup is lost.  Calling the joiner
+    // with mu_task_call() would work, but nests the joiner inside this task.
+    // Instead, joiner_notify() counts the completion and schedules the joiner,
+    // which then consumes every completion posted since it last ran.
+    joiner_notify(self->joiner);
   }
 
 }
@@ -34,6 +34,7 @@ extern "C" {
 
 #include "mu_platform.h"
 #include "mulib.h"
+#include "joiner.h"
 
 // =============================================================================
 // Types and definitions
@@ -41,7 +42,7 @@ extern "C" {
 typedef struct {
   mu_task_t task;
   const char *name;
-  mu_task_t *on_completion;
+  joiner_ctx_t *joiner;
 } sleeper_ctx_t;
 
 // =============================================================================
@@ -49,7 +50,7 @@ typedef struct {
 
 mu_task_t *sleeper_init(sleeper_ctx_t *ctx,
                         const char *name,
-                        mu_task_t *on_completion);
+                        joiner_ctx_t *joiner);
 
 mu_task_t *sleeper_task(sleeper_ctx_t *ctx);
 
@@ -107,6 +107,9 @@ static void task_fn(void *ctx, void *arg) {
     mu_sched_remove_task(sleeper_task(&s_sleeper_a));
     mu_sched_remove_task(sleeper_task(&s_sleeper_b));
     mu_sched_remove_task(sleeper_task(&s_sleeper_c));
+    // Likewise, a sleeper that woke after the timeout may have notified the
+    // joiner, leaving it in the schedule.
+    mu_sched_remove_task(&s_joiner_wto.task);
   }
 
   // initialize the joiner object.  Upon completion (when all tasks have
@@ -54,13 +54,18 @@ mu_task_t *joiner_wto_init(joiner_wto_ctx_t *ctx, mu_task_t *on_completion) {
   mu_task_init(&ctx->task, task_fn, ctx, "Joiner");
   ctx->on_completion = on_completion;
   ctx->pending_count = 0;
+  mu_signal_init(&ctx->done, &ctx->task);
 
   return &ctx->task;
 }
 
-mu_task_t *joiner_wto_add_task(joiner_wto_ctx_t *ctx) {
+joiner_wto_ctx_t *joiner_wto_add_task(joiner_wto_ctx_t *ctx) {
   ctx->pending_count += 1;
-  return &ctx->task;
+  return ctx;
+}
+
+void joiner_wto_notify(joiner_wto_ctx_t *ctx) {
+  mu_signal_post(&ctx->done);
 }
 
 void joiner_wto_set_timeout_at(joiner_wto_ctx_t *ctx, mu_time_t at) {
@@ -76,9 +81,13 @@ static void task_fn(void *ctx, void *arg) {
   joiner_wto_ctx_t *self = (joiner_wto_ctx_t *)ctx;
   (void)arg;  // unused
 
+  // consume every completion posted since the joiner last ran, even after a
+  // timeout, so late completions don't carry over into the next round.
+  int completed = mu_signal_take(&self->done);
   if (self->pending_count > 0) {
-    self->pending_count -= 1;
-    if (self->pending_count == 0) {
+    self->pending_count -= completed;
+    if (self->pending_count <= 0) {
+      self->pending_count = 0;
       mu_sched_remove_task(&self->timeout_task);  // cancel timeout task
       endgame(self, arg, "completed");
     }
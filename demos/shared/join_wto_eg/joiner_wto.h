@@ -34,6 +34,7 @@ extern "C" {
 
 #include "mu_platform.h"
 #include "mulib.h"
+#include "../mu_signal/mu_signal.h"
 
 // =============================================================================
 // Types and definitions
@@ -41,6 +42,7 @@ extern "C" {
 typedef struct {
   mu_task_t task;
   int pending_count;
+  mu_signal_t done;  // posted once per completed task
   mu_task_t timeout_task;
   mu_task_t *on_completion;
 } joiner_wto_ctx_t;
@@ -50,7 +52,15 @@ typedef struct {
 
 mu_task_t *joiner_wto_init(joiner_wto_ctx_t *ctx, mu_task_t *on_completion);
 
-mu_task_t *joiner_wto_add_task(joiner_wto_ctx_t *ctx);
+joiner_wto_ctx_t *joiner_wto_add_task(joiner_wto_ctx_t *ctx);
+
+/**
+ * @brief Notify the joiner that one of its tasks has completed.
+ *
+ * Notifications are counted with a mu_signal, so the joiner is scheduled at
+ * most once no matter how many tasks complete before it runs.
+ */
+void joiner_wto_notify(joiner_wto_ctx_t *ctx);
 
 void joiner_wto_set_timeout_at(joiner_wto_ctx_t *ctx, mu_time_t at);
 
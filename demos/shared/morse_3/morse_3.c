@@ -30,6 +30,8 @@
 #include "mu_platform.h"  // must precede #include mulib.h
 #include "mulib.h"
 #include "morse_str.h"
+#include "mu_coro.h"
+#include <stdbool.h>
 #include <stdio.h>
 #include <stddef.h>
 
@@ -42,6 +44,7 @@
 
 typedef struct {
   mu_task_t task;
+  mu_coro_t coro;
 } ctx_t;
 
 // =============================================================================
@@ -64,6 +67,7 @@ void morse_3_init(void) {
   mu_stddemo_printf("\r\nmorse_3 v%s\n", VERSION);
 
   mu_task_init(&s_ctx.task, task_fn, &s_ctx, "Morse 3");
+  MU_CORO_INIT(&s_ctx.coro);
 
   mu_sched_task_now(&s_ctx.task);
 }
@@ -80,6 +84,12 @@ static void task_fn(void *ctx, void *arg) {
   ctx_t *self = (ctx_t *)ctx;
   (void)arg;  // unused
 
-  // Schedule sub-task to blink the message and upon completion, call this task.
-  mu_sched_task_now(morse_str_init(MESSAGE, &self->task));
+  MU_CORO_BEGIN(&self->coro);
+
+  while (true) {
+    // Blink the message and resume here when it completes.
+    MU_AWAIT(&self->coro, morse_str_init(MESSAGE, &self->task));
+  }
+
+  MU_CORO_END(&self->coro);
 }
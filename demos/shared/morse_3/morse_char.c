@@ -29,6 +29,7 @@
 
 #include "mu_platform.h"  // must precede #include mulib.h
 #include "mulib.h"
+#include "mu_coro.h"
 #include <stdio.h>
 
 // =============================================================================
@@ -47,6 +48,7 @@
 // Define the context for a morse_char_task.
 typedef struct {
   mu_task_t task;            // the task object
+  mu_coro_t coro;            // the task's resume point
   const char *s;             // the character being printed
   mu_task_t *on_completion;  // a task to call upon completion
 } morse_char_ctx_t;
@@ -56,6 +58,11 @@ typedef struct {
 
 static void task_fn(void *ctx, void *arg);
 
+/**
+ * @brief Return how long to hold the LED on (or off) for a '.', '-' or ' '.
+ */
+static mu_duration_t get_symbol_duration(char symbol);
+
 /**
  * @brief Convert a single ASCII char into a morse string of dots and dashes.
  *
@@ -146,6 +153,7 @@ mu_task_t *morse_char_init(char ascii, mu_task_t *on_completion) {
   mu_task_init(&s_ctx.task, task_fn, &s_ctx, "Morse Char");
 
   // Initialize s_ctx
+  MU_CORO_INIT(&s_ctx.coro);
   s_ctx.s = get_morse_string(ascii);
   s_ctx.on_completion = on_completion;
 
@@ -164,30 +172,31 @@ static void task_fn(void *ctx, void *arg) {
   morse_char_ctx_t *self = (morse_char_ctx_t *)ctx;
   (void)arg;  // unused
 
-  switch(*self->s++) {
-    case '.':  // dot: turn LED on for MORSE_SHORT_MARK
-    mu_stddemo_led_set(true);
-    mu_sched_reschedule_in(MORSE_SHORT_MARK);
-    break;
-
-    case '-':  // dash: turn LED on for MORSE_LONG_MARK
-    mu_stddemo_led_set(true);
-    mu_sched_reschedule_in(MORSE_LONG_MARK);
-    break;
-
-    case ' ':  // intra-character: turn LED off for MORSE_INTRA_CHAR_GAP
-    mu_stddemo_led_set(false);
-    mu_sched_reschedule_in(MORSE_INTRA_CHAR_GAP);
-    break;
-
-    case '\0':
-    // Arrive here when the character has been emitted: turn the LED off and
-    // call the on_completion task after MORSE_INTER_CHAR_GAP
-    mu_stddemo_led_set(false);
-    if (self->on_completion != NULL) {
-      mu_sched_task_in(self->on_completion, MORSE_INTER_CHAR_GAP);
-    }
-    break;
+  MU_CORO_BEGIN(&self->coro);
+
+  while (*self->s != '\0') {
+    // dot or dash: LED on.  intra-character gap: LED off.
+    mu_stddemo_led_set(*self->s != ' ');
+    MU_AWAIT_FOR(&self->coro, get_symbol_duration(*self->s++));
+  }
+
+  // Arrive here when the character has been emitted: turn the LED off and
+  // call the on_completion task after MORSE_INTER_CHAR_GAP
+  mu_stddemo_led_set(false);
+  if (self->on_completion != NULL) {
+    mu_sched_task_in(self->on_completion, MORSE_INTER_CHAR_GAP);
+  }
+
+  MU_CORO_END(&self->coro);
+}
+
+static mu_duration_t get_symbol_duration(char symbol) {
+  if (symbol == '.') {
+    return MORSE_SHORT_MARK;
+  } else if (symbol == '-') {
+    return MORSE_LONG_MARK;
+  } else {
+    return MORSE_INTRA_CHAR_GAP;
   }
 }
 
@@ -30,6 +30,7 @@
 #include "mu_platform.h"  // must precede #include mulib.h
 #include "mulib.h"
 #include "morse_char.h"
+#include "mu_coro.h"
 #include <stdio.h>
 
 // =============================================================================
@@ -37,6 +38,7 @@
 
 typedef struct {
   mu_task_t task;
+  mu_coro_t coro;
   const char *str;
   mu_task_t *on_completion;
 } ctx_t;
@@ -57,7 +59,8 @@ static ctx_t s_ctx;
 mu_task_t *morse_str_init(const char *str, mu_task_t *on_completion) {
   mu_task_init(&s_ctx.task, task_fn, &s_ctx, "Morse Str");
 
-  // Initialize s_morse_2_ctx
+  // Initialize s_ctx
+  MU_CORO_INIT(&s_ctx.coro);
   s_ctx.str = str;
   s_ctx.on_completion = on_completion;
 
@@ -74,19 +77,19 @@ static void task_fn(void *ctx, void *arg) {
   ctx_t *self = (ctx_t *)ctx;
   (void)arg;  // unused
 
-  // Fetch the next character in the string
-  char ch = *self->str++;
+  MU_CORO_BEGIN(&self->coro);
 
-  if (ch != '\0') {
-    // Schedule sub-task to blink the ascii as morse code, and upon completion,
-    // call this task again.
-    mu_sched_task_now(morse_char_init(ch, &self->task));
+  while (*self->str != '\0') {
+    // Start a sub-task to blink the next character as morse code, and resume
+    // here when it completes.
+    MU_AWAIT(&self->coro, morse_char_init(*self->str++, &self->task));
+  }
 
-  } else {
-    // Completed the string.   Call the on_completion task (if provided) after
-    // a one second delay.
-    if (self->on_completion != NULL) {
-      mu_sched_task_in(self->on_completion, MU_TIME_MS_TO_DURATION(1000));
-    }
+  // Completed the string.   Call the on_completion task (if provided) after
+  // a one second delay.
+  if (self->on_completion != NULL) {
+    mu_sched_task_in(self->on_completion, MU_TIME_MS_TO_DURATION(1000));
   }
+
+  MU_CORO_END(&self->coro);
 }
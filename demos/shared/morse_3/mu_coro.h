@@ -0,0 +1,146 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * mu_coro: stackless coroutines for mu_task functions.
+ *
+ * A long-running task can be written as straight-line code that suspends at
+ * MU_YIELD(), MU_AWAIT_FOR(), MU_AWAIT_UNTIL() or MU_AWAIT().  Each suspend
+ * point returns to the scheduler, so other tasks get to run, and the next
+ * call to the task function resumes just after the suspend point.  Compare
+ * morse_char.c here with the hand-written state machine in morse_2.
+ *
+ *     typedef struct {
+ *       mu_task_t task;
+ *       mu_coro_t coro;
+ *       int i;             // state that must survive a suspend goes here
+ *     } blinker_ctx_t;
+ *
+ *     static void blinker_fn(void *ctx, void *arg) {
+ *       blinker_ctx_t *self = (blinker_ctx_t *)ctx;
+ *       MU_CORO_BEGIN(&self->coro);
+ *       for (self->i = 0; self->i < 10; self->i++) {
+ *         mu_stddemo_led_set((self->i & 1) == 0);
+ *         MU_AWAIT_FOR(&self->coro, MU_TIME_MS_TO_DURATION(100));
+ *       }
+ *       MU_CORO_END(&self->coro);
+ *     }
+ *
+ * Rules, as with any protothread:
+ *
+ * - Local variables don't survive a suspend.  Keep state in the task's
+ *   context.
+ * - Don't suspend from inside a `switch` statement of your own.  The macros
+ *   are built on a `switch` over the resume point.
+ * - Suspend only from the coroutine's own task function, not from a helper
+ *   it calls.
+ * - MU_CORO_END() resets the coroutine, so the next call to the task starts
+ *   over from MU_CORO_BEGIN().
+ */
+
+#ifndef _MU_CORO_H_
+#define _MU_CORO_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// Includes
+
+#include "mu_platform.h"  // must precede #include mulib.h
+#include "mulib.h"
+#include <stdint.h>
+
+// =============================================================================
+// Types and definitions
+
+/**
+ * @brief The resume point of a coroutine.  Initialize to 0 (or call
+ * MU_CORO_INIT()) before the first call.
+ */
+typedef uint16_t mu_coro_t;
+
+#define MU_CORO_INIT(_coro) (*(_coro) = 0)
+
+/**
+ * @brief Start the coroutine body.  Must be the first statement in the task
+ * function that touches the coroutine.
+ */
+#define MU_CORO_BEGIN(_coro)                                                   \
+  switch (*(_coro)) {                                                          \
+  case 0:
+
+/**
+ * @brief End the coroutine body.  The next call starts from the beginning.
+ */
+#define MU_CORO_END(_coro)                                                     \
+  }                                                                            \
+  *(_coro) = 0
+
+// Record the resume point, run _suspend to arrange the next call, return to
+// the scheduler, and resume here when called again.
+#define MU_CORO_SUSPEND_(_coro, _suspend)                                      \
+  do {                                                                         \
+    *(_coro) = __LINE__;                                                       \
+    _suspend;                                                                  \
+    return;                                                                    \
+  case __LINE__:;                                                              \
+  } while (0)
+
+/**
+ * @brief Let every other runnable task run, then resume.
+ */
+#define MU_YIELD(_coro) MU_CORO_SUSPEND_(_coro, mu_sched_reschedule_now())
+
+/**
+ * @brief Resume after the given duration.
+ */
+#define MU_AWAIT_FOR(_coro, _dt)                                               \
+  MU_CORO_SUSPEND_(_coro, mu_sched_reschedule_in(_dt))
+
+/**
+ * @brief Resume at the given time.
+ */
+#define MU_AWAIT_UNTIL(_coro, _at)                                             \
+  MU_CORO_SUSPEND_(_coro, mu_sched_task_at(mu_sched_get_current_task(), _at))
+
+/**
+ * @brief Start a sub-task and resume when it completes.
+ *
+ * The sub-task must schedule this coroutine's task when it is done.  That is
+ * the `on_completion` convention used throughout the demos, e.g.
+ * `MU_AWAIT(&self->coro, morse_char_init(ch, &self->task))`.
+ */
+#define MU_AWAIT(_coro, _subtask)                                              \
+  MU_CORO_SUSPEND_(_coro, mu_sched_task_now(_subtask))
+
+// =============================================================================
+// Declarations
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _MU_CORO_H_
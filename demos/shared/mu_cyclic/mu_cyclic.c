@@ -0,0 +1,161 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// Includes
+
+#include "mu_cyclic.h"
+#include "mu_config.h"
+#include "mulib.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// Local types and definitions
+
+// =============================================================================
+// Local (forward) declarations
+
+static void cyclic_task_fn(void *ctx, void *arg);
+
+static uint64_t gcd(uint64_t a, uint64_t b);
+
+// =============================================================================
+// Local storage
+
+// =============================================================================
+// Public code
+
+mu_cyclic_err_t mu_cyclic_init(mu_cyclic_t *cyclic,
+                               const mu_cyclic_entry_t *entries,
+                               size_t n_entries,
+                               uint32_t *masks,
+                               size_t n_masks) {
+  uint64_t minor_frame = 0;
+  uint64_t n_frames = 1;
+
+  if (n_entries == 0 || n_entries > MU_CYCLIC_MAX_ENTRIES) {
+    return MU_CYCLIC_ERR_SIZE;
+  }
+  for (size_t i = 0; i < n_entries; i++) {
+    if (entries[i].period <= 0) {
+      return MU_CYCLIC_ERR_PERIOD;
+    }
+    minor_frame = gcd(minor_frame, (uint64_t)entries[i].period);
+  }
+
+  // The major frame is the LCM of the periods.  Count it in minor frames, and
+  // give up as soon as it outgrows the masks, before it can overflow.
+  for (size_t i = 0; i < n_entries; i++) {
+    uint64_t frames = (uint64_t)entries[i].period / minor_frame;
+    n_frames = n_frames / gcd(n_frames, frames) * frames;
+    if (n_frames > n_masks) {
+      return MU_CYCLIC_ERR_SIZE;
+    }
+  }
+
+  for (size_t f = 0; f < n_frames; f++) {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < n_entries; i++) {
+      if ((f * minor_frame) % (uint64_t)entries[i].period == 0) {
+        mask |= (uint32_t)1 << i;
+      }
+    }
+    masks[f] = mask;
+  }
+
+  mu_task_init(&cyclic->task, cyclic_task_fn, cyclic, "Cyclic");
+  cyclic->entries = entries;
+  cyclic->n_entries = n_entries;
+  cyclic->masks = masks;
+  cyclic->n_frames = (size_t)n_frames;
+  cyclic->minor_frame = (mu_duration_t)minor_frame;
+  cyclic->frame = 0;
+  cyclic->frame_start = 0;
+  cyclic->overrun_count = 0;
+  cyclic->overrun_name = NULL;
+  return MU_CYCLIC_ERR_NONE;
+}
+
+mu_sched_err_t mu_cyclic_start(mu_cyclic_t *cyclic, mu_time_t at) {
+  cyclic->frame = 0;
+  cyclic->frame_start = at;
+  return mu_sched_task_at(&cyclic->task, at);
+}
+
+void mu_cyclic_stop(mu_cyclic_t *cyclic) {
+  mu_sched_remove_task(&cyclic->task);
+}
+
+mu_task_t *mu_cyclic_task(mu_cyclic_t *cyclic) { return &cyclic->task; }
+
+mu_duration_t mu_cyclic_minor_frame(mu_cyclic_t *cyclic) {
+  return cyclic->minor_frame;
+}
+
+size_t mu_cyclic_frame_count(mu_cyclic_t *cyclic) { return cyclic->n_frames; }
+
+unsigned long mu_cyclic_overrun_count(mu_cyclic_t *cyclic) {
+  return cyclic->overrun_count;
+}
+
+const char *mu_cyclic_overrun_name(mu_cyclic_t *cyclic) {
+  return cyclic->overrun_name;
+}
+
+// =============================================================================
+// Local (private) code
+
+static void cyclic_task_fn(void *ctx, void *arg) {
+  mu_cyclic_t *self = (mu_cyclic_t *)ctx;
+  uint32_t mask = self->masks[self->frame];
+  const mu_cyclic_entry_t *entry = self->entries;
+  const mu_cyclic_entry_t *last = NULL;
+  (void)arg;
+
+  for (; mask != 0; mask >>= 1, entry++) {
+    if (mask & 1) {
+      entry->fn(entry->ctx, NULL);
+      last = entry;
+    }
+  }
+
+  self->frame = (self->frame + 1 == self->n_frames) ? 0 : self->frame + 1;
+  self->frame_start = mu_time_offset(self->frame_start, self->minor_frame);
+  if (mu_time_follows(mu_sched_get_current_time(), self->frame_start)) {
+    // Overran: the next frame is already due and will start late.
+    self->overrun_count += 1;
+    self->overrun_name = last ? last->name : NULL;
+  }
+  mu_sched_task_at(&self->task, self->frame_start);
+}
+
+static uint64_t gcd(uint64_t a, uint64_t b) {
+  while (b != 0) {
+    uint64_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
@@ -0,0 +1,181 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * mu_cyclic: run a fixed set of periodic tasks from a precomputed table.
+ *
+ * With mu_timer_periodic(), every period of every timer is an ordered
+ * reinsertion into the schedule.  A cyclic executive runs the whole periodic
+ * set from one mu_task_t instead.  The minor frame is the GCD of the periods
+ * and the major frame is their LCM.  mu_cyclic_init() works out, once, which
+ * entries are due in each minor frame.  At run time the table task calls the
+ * entries due in the current frame, in table order, and schedules itself for
+ * the start of the next frame: one insertion per minor frame, however many
+ * entries there are.
+ *
+ * The table is usually declared with an X-macro, in the style of
+ * DEFINE_FSM_STATES:
+ *
+ *     #define DEFINE_CYCLIC_TASKS                                             \
+ *       DEFINE_CYCLIC_TASK(SENSE, sense_fn, 10)                               \
+ *       DEFINE_CYCLIC_TASK(CONTROL, control_fn, 50)                           \
+ *       DEFINE_CYCLIC_TASK(REPORT, report_fn, 1000)
+ *
+ *     #define DEFINE_CYCLIC_TASK(_name, _fn, _period_ms)                      \
+ *       MU_CYCLIC_ENTRY(#_name, _fn, NULL, MU_TIME_MS_TO_DURATION(_period_ms)),
+ *     static const mu_cyclic_entry_t s_table[] = {DEFINE_CYCLIC_TASKS};
+ *     #undef DEFINE_CYCLIC_TASK
+ *
+ *     // 10 mSec minor frame, 1000 mSec major frame
+ *     static uint32_t s_masks[100];
+ *
+ * Frames are scheduled at absolute times, so they don't drift.  A frame that
+ * runs past the start of the next one is counted as an overrun, and the name
+ * of the last entry it ran is kept for the application to log.  The next
+ * frame then starts late rather than being skipped, so every entry still runs
+ * once per period.
+ *
+ * Entry functions are called as fn(ctx, NULL) from within the table task, so
+ * they must not call mu_sched_reschedule_xxx().
+ */
+
+#ifndef _MU_CYCLIC_H_
+#define _MU_CYCLIC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// Includes
+
+#include "mu_config.h"
+#include "mulib.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// Types and definitions
+
+// Each minor frame's entries are a bitmask, so a table holds up to 32 entries.
+#define MU_CYCLIC_MAX_ENTRIES 32
+
+typedef enum {
+  MU_CYCLIC_ERR_NONE,
+  MU_CYCLIC_ERR_PERIOD,  // an entry's period isn't positive
+  MU_CYCLIC_ERR_SIZE,    // too many entries, or too few masks for the frames
+} mu_cyclic_err_t;
+
+typedef struct {
+  const char *name;
+  mu_task_fn fn;
+  void *ctx;
+  mu_duration_t period;
+} mu_cyclic_entry_t;
+
+#define MU_CYCLIC_ENTRY(_name, _fn, _ctx, _period)                             \
+  { (_name), (_fn), (_ctx), (_period) }
+
+typedef struct {
+  mu_task_t task;
+  const mu_cyclic_entry_t *entries;
+  size_t n_entries;
+  uint32_t *masks;            // entries due in each minor frame
+  size_t n_frames;            // minor frames per major frame
+  mu_duration_t minor_frame;
+  size_t frame;               // index of the next frame to run
+  mu_time_t frame_start;      // when the next frame is due
+  unsigned long overrun_count;
+  const char *overrun_name;   // last entry run by the last frame to overrun
+} mu_cyclic_t;
+
+// =============================================================================
+// Declarations
+
+/**
+ * @brief Initialize a cyclic executive over a table of periodic entries.
+ *
+ * Computes the minor and major frames and fills in one mask per minor frame.
+ * Does not schedule anything: call mu_cyclic_start() for that.
+ *
+ * @param cyclic The cyclic executive.
+ * @param entries The table.  Must remain valid while the executive runs.
+ * @param n_entries Number of entries, 1 to MU_CYCLIC_MAX_ENTRIES.
+ * @param masks Storage for one mask per minor frame.
+ * @param n_masks Number of masks available.  Must be at least the number of
+ *        minor frames in the major frame.
+ * @return MU_CYCLIC_ERR_PERIOD if a period isn't positive, MU_CYCLIC_ERR_SIZE
+ *         if there are too many entries or too few masks, else
+ *         MU_CYCLIC_ERR_NONE.
+ */
+mu_cyclic_err_t mu_cyclic_init(mu_cyclic_t *cyclic,
+                               const mu_cyclic_entry_t *entries,
+                               size_t n_entries,
+                               uint32_t *masks,
+                               size_t n_masks);
+
+/**
+ * @brief Run the first frame at the given time, and every frame after it.
+ *
+ * Every entry is due in the first frame.  Restarting an executive that is
+ * already running starts over from the first frame.
+ */
+mu_sched_err_t mu_cyclic_start(mu_cyclic_t *cyclic, mu_time_t at);
+
+/**
+ * @brief Stop running frames.
+ */
+void mu_cyclic_stop(mu_cyclic_t *cyclic);
+
+/**
+ * @brief Return the task that runs the frames.
+ */
+mu_task_t *mu_cyclic_task(mu_cyclic_t *cyclic);
+
+/**
+ * @brief Return the minor frame: the GCD of the entries' periods.
+ */
+mu_duration_t mu_cyclic_minor_frame(mu_cyclic_t *cyclic);
+
+/**
+ * @brief Return the number of minor frames in the major frame.
+ */
+size_t mu_cyclic_frame_count(mu_cyclic_t *cyclic);
+
+/**
+ * @brief Return the number of frames that ran past the start of the next.
+ */
+unsigned long mu_cyclic_overrun_count(mu_cyclic_t *cyclic);
+
+/**
+ * @brief Return the name of the last entry run by the last frame to overrun,
+ * or NULL if no frame has overrun.
+ */
+const char *mu_cyclic_overrun_name(mu_cyclic_t *cyclic);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _MU_CYCLIC_H_
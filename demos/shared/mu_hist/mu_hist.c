@@ -0,0 +1,214 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// Includes
+
+#include "mu_hist.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// Local types and definitions
+
+#define SUB_BUCKETS (1u << MU_HIST_SUB_BITS)
+#define SUB_MASK (SUB_BUCKETS - 1)
+
+// =============================================================================
+// Local (forward) declarations
+
+/**
+ * @brief Return the position of the most significant set bit of a non-zero
+ * value.
+ */
+static unsigned msb(uint32_t value);
+
+static void put_uint32(uint32_t value, mu_hist_putc_fn putc_fn);
+
+static void write_uint32(uint32_t value, mu_hist_write_fn write_fn);
+
+// =============================================================================
+// Local storage
+
+// =============================================================================
+// Public code
+
+mu_hist_t *mu_hist_init(mu_hist_t *hist, uint32_t *counts) {
+  hist->counts = counts;
+  mu_hist_reset(hist);
+  return hist;
+}
+
+void mu_hist_reset(mu_hist_t *hist) {
+  for (size_t i = 0; i < MU_HIST_BUCKETS; i++) {
+    hist->counts[i] = 0;
+  }
+  hist->total = 0;
+  hist->max = 0;
+}
+
+void mu_hist_record(mu_hist_t *hist, uint32_t value) {
+  uint32_t *count = &hist->counts[mu_hist_bucket_index(value)];
+
+  if (*count != UINT32_MAX) {
+    *count += 1;
+  }
+  if (hist->total != UINT32_MAX) {
+    hist->total += 1;
+  }
+  if (value > hist->max) {
+    hist->max = value;
+  }
+}
+
+uint32_t mu_hist_count(const mu_hist_t *hist) {
+  return hist->total;
+}
+
+uint32_t mu_hist_max(const mu_hist_t *hist) {
+  return hist->max;
+}
+
+uint32_t mu_hist_percentile(const mu_hist_t *hist, uint32_t permille) {
+  uint64_t rank;
+  uint64_t cumulative = 0;
+
+  if (hist->total == 0) {
+    return 0;
+  }
+  if (permille > 1000) {
+    permille = 1000;
+  }
+  rank = ((uint64_t)hist->total * permille + 999) / 1000;
+  if (rank == 0) {
+    rank = 1;
+  }
+  for (size_t i = 0; i < MU_HIST_BUCKETS; i++) {
+    cumulative += hist->counts[i];
+    if (cumulative >= rank) {
+      uint32_t upper = mu_hist_bucket_upper(i);
+      return (upper < hist->max) ? upper : hist->max;
+    }
+  }
+  // Only reachable once a bucket count has saturated.
+  return hist->max;
+}
+
+size_t mu_hist_bucket_index(uint32_t value) {
+  unsigned shift;
+
+  if (value < SUB_BUCKETS) {
+    return value;
+  }
+  // The bits below the most significant bit pick the sub-bucket.
+  shift = msb(value) - MU_HIST_SUB_BITS;
+  return ((size_t)(shift + 1) << MU_HIST_SUB_BITS) |
+         ((value >> shift) & SUB_MASK);
+}
+
+uint32_t mu_hist_bucket_lower(size_t index) {
+  unsigned shift;
+
+  if (index < SUB_BUCKETS) {
+    return (uint32_t)index;
+  }
+  shift = (unsigned)(index >> MU_HIST_SUB_BITS) - 1;
+  return (uint32_t)(SUB_BUCKETS | (index & SUB_MASK)) << shift;
+}
+
+uint32_t mu_hist_bucket_upper(size_t index) {
+  unsigned shift;
+
+  if (index < SUB_BUCKETS) {
+    return (uint32_t)index;
+  }
+  shift = (unsigned)(index >> MU_HIST_SUB_BITS) - 1;
+  return mu_hist_bucket_lower(index) + (((uint32_t)1 << shift) - 1);
+}
+
+void mu_hist_dump_text(const mu_hist_t *hist, mu_hist_putc_fn putc_fn) {
+  for (size_t i = 0; i < MU_HIST_BUCKETS; i++) {
+    if (hist->counts[i] != 0) {
+      put_uint32(mu_hist_bucket_upper(i), putc_fn);
+      putc_fn(' ');
+      put_uint32(hist->counts[i], putc_fn);
+      putc_fn('\n');
+    }
+  }
+}
+
+void mu_hist_dump_binary(const mu_hist_t *hist, mu_hist_write_fn write_fn) {
+  uint8_t header[4];
+
+  header[0] = MU_HIST_BINARY_VERSION;
+  header[1] = MU_HIST_SUB_BITS;
+  header[2] = (uint8_t)(MU_HIST_BUCKETS & 0xff);
+  header[3] = (uint8_t)(MU_HIST_BUCKETS >> 8);
+  write_fn(header, sizeof(header));
+  write_uint32(hist->total, write_fn);
+  write_uint32(hist->max, write_fn);
+  for (size_t i = 0; i < MU_HIST_BUCKETS; i++) {
+    write_uint32(hist->counts[i], write_fn);
+  }
+}
+
+// =============================================================================
+// Local (private) code
+
+static unsigned msb(uint32_t value) {
+#if defined(__GNUC__)
+  // unsigned long is at least 32 bits, and 64 on LP64 hosts.
+  return (unsigned)(sizeof(unsigned long) * 8 - 1) -
+         (unsigned)__builtin_clzl(value);
+#else
+  unsigned bit = 0;
+  while (value >>= 1) {
+    bit += 1;
+  }
+  return bit;
+#endif
+}
+
+static void put_uint32(uint32_t value, mu_hist_putc_fn putc_fn) {
+  char digits[10];
+  int n = 0;
+
+  do {
+    digits[n++] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (n > 0) {
+    putc_fn(digits[--n]);
+  }
+}
+
+static void write_uint32(uint32_t value, mu_hist_write_fn write_fn) {
+  uint8_t buf[4];
+
+  buf[0] = (uint8_t)value;
+  buf[1] = (uint8_t)(value >> 8);
+  buf[2] = (uint8_t)(value >> 16);
+  buf[3] = (uint8_t)(value >> 24);
+  write_fn(buf, sizeof(buf));
+}
@@ -0,0 +1,173 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * mu_hist: a fixed-size, log-linear histogram of non-negative values.
+ *
+ * Max latency hides the shape of the tail.  A mu_hist keeps a count per
+ * bucket, in the style of an HDR histogram, so p50, p99 and p99.9 can be read
+ * back or shipped off the board and graphed:
+ *
+ * - A value's bucket is its most significant bit plus the MU_HIST_SUB_BITS
+ *   bits below it, so there are 2^MU_HIST_SUB_BITS buckets per power of two.
+ *   With 2 sub-bits, values below 8 get a bucket each, and every bucket's
+ *   upper bound is within 25% of any value in it.
+ * - The caller supplies the counts, MU_HIST_BUCKETS of them.  There is no
+ *   malloc.  Counts saturate rather than wrap.
+ *
+ *     static uint32_t s_latency_counts[MU_HIST_BUCKETS];
+ *     static mu_hist_t s_latency;
+ *
+ *     mu_hist_init(&s_latency, s_latency_counts);
+ *     ...
+ *     mu_hist_record(&s_latency, lateness);
+ *     ...
+ *     p999 = mu_hist_percentile(&s_latency, 999);
+ *
+ * mu_hist_record() is not interrupt safe: record from task context, or from
+ * one ISR only.
+ */
+
+#ifndef _MU_HIST_H_
+#define _MU_HIST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// Includes
+
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// Types and definitions
+
+#define MU_HIST_SUB_BITS 2
+
+// One bucket per value below 2^MU_HIST_SUB_BITS, then 2^MU_HIST_SUB_BITS per
+// power of two up to 2^32: 124 buckets with 2 sub-bits.
+#define MU_HIST_BUCKETS ((32 - MU_HIST_SUB_BITS + 1) << MU_HIST_SUB_BITS)
+
+// Version of the format written by mu_hist_dump_binary().
+#define MU_HIST_BINARY_VERSION 1
+
+typedef struct {
+  uint32_t *counts;  // MU_HIST_BUCKETS counts, supplied by the caller
+  uint32_t total;    // number of values recorded, saturating
+  uint32_t max;      // largest value recorded
+} mu_hist_t;
+
+// Write one character of a text dump.
+typedef void (*mu_hist_putc_fn)(char ch);
+
+// Write n bytes of a binary dump.
+typedef void (*mu_hist_write_fn)(const uint8_t *buf, size_t n);
+
+// =============================================================================
+// Declarations
+
+/**
+ * @brief Initialize a histogram over caller-supplied counts, and clear it.
+ *
+ * @param hist The histogram.
+ * @param counts Storage for MU_HIST_BUCKETS counts.
+ * @return hist
+ */
+mu_hist_t *mu_hist_init(mu_hist_t *hist, uint32_t *counts);
+
+/**
+ * @brief Clear every count.
+ */
+void mu_hist_reset(mu_hist_t *hist);
+
+/**
+ * @brief Count one value.
+ */
+void mu_hist_record(mu_hist_t *hist, uint32_t value);
+
+/**
+ * @brief Return the number of values recorded since the last reset.
+ */
+uint32_t mu_hist_count(const mu_hist_t *hist);
+
+/**
+ * @brief Return the largest value recorded since the last reset, or 0.
+ */
+uint32_t mu_hist_max(const mu_hist_t *hist);
+
+/**
+ * @brief Return an upper bound on the given fraction of the values recorded.
+ *
+ * Finds the bucket that holds the value of rank ceil(count * permille / 1000)
+ * and returns its upper bound, or mu_hist_max() if that is smaller.
+ *
+ * @param hist The histogram.
+ * @param permille 500 for the median, 990 for p99, 999 for p99.9.  Values
+ *        above 1000 are treated as 1000.
+ * @return The bound, or 0 if nothing has been recorded.
+ */
+uint32_t mu_hist_percentile(const mu_hist_t *hist, uint32_t permille);
+
+/**
+ * @brief Return the index of the bucket that counts `value`.
+ */
+size_t mu_hist_bucket_index(uint32_t value);
+
+/**
+ * @brief Return the smallest value counted by bucket `index`.
+ */
+uint32_t mu_hist_bucket_lower(size_t index);
+
+/**
+ * @brief Return the largest value counted by bucket `index`.
+ */
+uint32_t mu_hist_bucket_upper(size_t index);
+
+/**
+ * @brief Write one "<bucket upper bound> <count>\n" line per non-empty
+ * bucket, in increasing order.
+ */
+void mu_hist_dump_text(const mu_hist_t *hist, mu_hist_putc_fn putc_fn);
+
+/**
+ * @brief Write the histogram in a compact binary form for a host to parse.
+ *
+ * Every multi-byte field is little-endian:
+ *
+ * - 1 byte: MU_HIST_BINARY_VERSION
+ * - 1 byte: MU_HIST_SUB_BITS
+ * - 2 bytes: MU_HIST_BUCKETS
+ * - 4 bytes: mu_hist_count()
+ * - 4 bytes: mu_hist_max()
+ * - 4 bytes per bucket: the counts, in bucket order
+ */
+void mu_hist_dump_binary(const mu_hist_t *hist, mu_hist_write_fn write_fn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _MU_HIST_H_
@@ -0,0 +1,151 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * mu_signal: a counting signal that schedules its target task at most once.
+ *
+ * Calling mu_sched_task_now() on a task that is already scheduled just moves
+ * it, so two posts that arrive before the task runs look like one.  A
+ * mu_signal counts posts instead.  Only the post that takes the count from
+ * zero schedules the target.  Later posts only add to the count.  When the
+ * target runs, mu_signal_take() returns the number of posts it is answering
+ * and clears the count:
+ *
+ *     static void joiner_fn(void *ctx, void *arg) {
+ *       joiner_ctx_t *self = (joiner_ctx_t *)ctx;
+ *       self->pending_count -= mu_signal_take(&self->done);
+ *       ...
+ *     }
+ *
+ * Post with mu_signal_post() from task context, or with mu_signal_isr_post()
+ * from interrupt level.  The count is updated with interrupts disabled, so
+ * posts from an ISR can't be lost between a take and the next post.  A post
+ * that arrives after the take schedules the target again.
+ *
+ * Everything here is static inline, so the header is all a project needs.
+ */
+
+#ifndef _MU_SIGNAL_H_
+#define _MU_SIGNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// Includes
+
+#include "mu_config.h"
+#include "mulib.h"
+#include <stdint.h>
+
+// =============================================================================
+// Types and definitions
+
+typedef struct {
+  volatile uint32_t count;  // posts since the last take
+  mu_task_t *target;        // task scheduled by the first post
+} mu_signal_t;
+
+// =============================================================================
+// Declarations
+
+/**
+ * @brief Initialize a signal with a zero count.
+ *
+ * @param sig The signal to initialize.
+ * @param target The task to schedule when the signal is posted.
+ * @return sig
+ */
+static inline mu_signal_t *mu_signal_init(mu_signal_t *sig, mu_task_t *target) {
+  sig->count = 0;
+  sig->target = target;
+  return sig;
+}
+
+/**
+ * @brief Add one to the count, and return true if this post took it from zero.
+ *
+ * Used by mu_signal_post() and mu_signal_isr_post().  Call those instead.
+ */
+static inline bool mu_signal_increment_(mu_signal_t *sig) {
+  uint32_t prev;
+
+  MU_DISABLE_INTERRUPTS();
+  prev = sig->count;
+  sig->count = prev + 1;
+  MU_ENABLE_INTERRUPTS();
+  return prev == 0;
+}
+
+/**
+ * @brief Post the signal from task context.
+ *
+ * Schedules the target with mu_sched_task_now() if this is the first post
+ * since the last mu_signal_take().
+ */
+static inline void mu_signal_post(mu_signal_t *sig) {
+  if (mu_signal_increment_(sig)) {
+    mu_sched_task_now(sig->target);
+  }
+}
+
+/**
+ * @brief Post the signal from interrupt level.
+ *
+ * Schedules the target with mu_sched_isr_task_now() if this is the first post
+ * since the last mu_signal_take(), so a burst of interrupts takes one slot in
+ * the ISR queue rather than one per post.
+ */
+static inline void mu_signal_isr_post(mu_signal_t *sig) {
+  if (mu_signal_increment_(sig)) {
+    mu_sched_isr_task_now(sig->target);
+  }
+}
+
+/**
+ * @brief Return the number of posts since the last take, and clear it.
+ *
+ * Call this from the target task.
+ */
+static inline uint32_t mu_signal_take(mu_signal_t *sig) {
+  uint32_t count;
+
+  MU_DISABLE_INTERRUPTS();
+  count = sig->count;
+  sig->count = 0;
+  MU_ENABLE_INTERRUPTS();
+  return count;
+}
+
+/**
+ * @brief Return the number of posts since the last take without clearing it.
+ */
+static inline uint32_t mu_signal_count(mu_signal_t *sig) { return sig->count; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _MU_SIGNAL_H_
@@ -0,0 +1,122 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * mu_time_scale: multiply-shift tick <-> millisecond conversions for the
+ * tick-based ports.
+ *
+ * x * num / den is computed as (x * MUL) >> SHIFT, where MUL is derived from
+ * SHIFT at compile time.  "Tick and millisecond conversions" in
+ * docs/porting_mulib.md explains how to choose each SHIFT and how to work out
+ * the error bounds.
+ *
+ * A port's mu_time.h defines its tick rate and its two SHIFTs, then includes
+ * this header:
+ *
+ *     #define MU_TIME_FREQUENCY RTC_FREQUENCY
+ *     #define MU_TIME_TICKS_TO_MS_SHIFT 12
+ *     #define MU_TIME_MS_TO_TICKS_SHIFT 26
+ *     #include "../../../shared/mu_time_scale/mu_time_scale.h"
+ *
+ * That defines the MULs and MU_TIME_MS_TO_DURATION(), and checks both SHIFTs
+ * at compile time.  Without MU_TIME_FREQUENCY, only the generic macros are
+ * defined, e.g. for a benchmark that scales by its own constants.
+ */
+
+#ifndef _MU_TIME_SCALE_H_
+#define _MU_TIME_SCALE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// Includes
+
+#include <stdint.h>
+
+// =============================================================================
+// Types and definitions
+
+// ceil(num * 2^shift / den), as a 32-bit multiplier
+#define MU_TIME_RECIPROCAL(num, den, shift)                                    \
+  ((uint32_t)((((uint64_t)(num) << (shift)) + (den) - 1) / (den)))
+
+// (x * mul) >> shift for non-negative x
+#define MU_TIME_SCALE(x, mul, shift) (((uint64_t)(x) * (mul)) >> (shift))
+
+// (x * mul) >> shift for signed x, truncating toward zero as integer division
+// does.  Evaluates x more than once.
+#define MU_TIME_SCALE_SIGNED(x, mul, shift)                                    \
+  ((x) < 0 ? -(int64_t)MU_TIME_SCALE(-(int64_t)(x), mul, shift)                \
+           : (int64_t)MU_TIME_SCALE(x, mul, shift))
+
+// Check the SHIFT rule in docs/porting_mulib.md at compile time: MUL fits in
+// 32 bits, so x * MUL can't overflow 64 bits for any 32-bit x, and SHIFT
+// either makes the conversion exact or is the largest SHIFT that keeps MUL in
+// 32 bits.  The preprocessor does its arithmetic in intmax_t, so these use a
+// cast-free MU_TIME_RECIPROCAL().
+#define MU_TIME_MUL_PP_(num, den, shift)                                       \
+  ((((num) << (shift)) + (den) - 1) / (den))
+#define MU_TIME_SHIFT_OK_PP_(num, den, shift)                                  \
+  (MU_TIME_MUL_PP_(num, den, shift) <= 0xFFFFFFFF &&                           \
+   (MU_TIME_MUL_PP_(num, den, shift) * (den) == ((num) << (shift)) ||          \
+    MU_TIME_MUL_PP_(num, den, (shift) + 1) > 0xFFFFFFFF))
+
+#ifdef MU_TIME_FREQUENCY
+
+#ifndef MU_TIME_TICKS_TO_MS_SHIFT
+  #error "Provide a platform-specific definition for MU_TIME_TICKS_TO_MS_SHIFT"
+#endif
+
+#ifndef MU_TIME_MS_TO_TICKS_SHIFT
+  #error "Provide a platform-specific definition for MU_TIME_MS_TO_TICKS_SHIFT"
+#endif
+
+#if !MU_TIME_SHIFT_OK_PP_(1000, MU_TIME_FREQUENCY, MU_TIME_TICKS_TO_MS_SHIFT)
+  #error "MU_TIME_TICKS_TO_MS_SHIFT breaks the rule in docs/porting_mulib.md"
+#endif
+
+#if !MU_TIME_SHIFT_OK_PP_(MU_TIME_FREQUENCY, 1000, MU_TIME_MS_TO_TICKS_SHIFT)
+  #error "MU_TIME_MS_TO_TICKS_SHIFT breaks the rule in docs/porting_mulib.md"
+#endif
+
+#define MU_TIME_TICKS_TO_MS_MUL                                                \
+  MU_TIME_RECIPROCAL(1000, MU_TIME_FREQUENCY, MU_TIME_TICKS_TO_MS_SHIFT)
+#define MU_TIME_MS_TO_TICKS_MUL                                                \
+  MU_TIME_RECIPROCAL(MU_TIME_FREQUENCY, 1000, MU_TIME_MS_TO_TICKS_SHIFT)
+
+// Convert milliseconds to ticks, truncating toward zero.  Folds to a constant
+// when ms is a constant.
+#define MU_TIME_MS_TO_DURATION(ms)                                             \
+  ((mu_duration_t)MU_TIME_SCALE_SIGNED(                                        \
+      (ms), MU_TIME_MS_TO_TICKS_MUL, MU_TIME_MS_TO_TICKS_SHIFT))
+
+#endif // MU_TIME_FREQUENCY
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _MU_TIME_SCALE_H_
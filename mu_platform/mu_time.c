@@ -87,23 +87,24 @@ bool mu_time_follows(mu_time_t t1, mu_time_t t2) {
 }
 
 /**
- * @brief Convert a duration to milliseconds.
+ * @brief Convert a duration to milliseconds, truncating toward zero.
  *
  * @param dt A duration object
- * @return The duration in seconds
+ * @return The duration in milliseconds
  */
 mu_duration_ms_t mu_time_duration_to_ms(mu_duration_t dt) {
-  #error "Provide a platform-specific implementation for mu_time_duration_to_ms()"
+  return (mu_duration_ms_t)MU_TIME_SCALE_SIGNED(
+      dt, MU_TIME_TICKS_TO_MS_MUL, MU_TIME_TICKS_TO_MS_SHIFT);
 }
 
 /**
- * @brief Convert milliseconds to a duration
+ * @brief Convert milliseconds to a duration, truncating toward zero.
  *
  * @param ms The duration in milliseconds
  * @return A duration object
  */
 mu_duration_t mu_time_ms_to_duration(mu_duration_ms_t ms) {
-  #error "Provide a platform-specific implementation for mu_time_ms_to_duration()"
+  return MU_TIME_MS_TO_DURATION(ms);
 }
 
 #ifdef MU_FLOAT
@@ -128,3 +129,34 @@ mu_duration_t mu_time_s_to_duration(MU_FLOAT s) {
 }
 
 #endif // #ifdef MU_FLOAT
+
+#ifdef MU_CAN_SLEEP
+/**
+ * @brief Sleep until the given time or until mu_time_wake() is called.
+ *
+ * A typical implementation arms a wakeup alarm for `until`, then disables
+ * interrupts, checks a "wake pending" flag set by mu_time_wake() and, if it
+ * is clear, enters low power mode in a way that re-enables interrupts
+ * atomically (e.g. WFI on ARM, __bis_SR_register(LPM3_bits | GIE) on MSP430).
+ *
+ * @param until The time at which to wake up.
+ */
+void mu_time_sleep_until(mu_time_t until) {
+  #error "Provide a platform-specific implementation for mu_time_sleep_until()"
+}
+
+/**
+ * @brief Sleep until mu_time_wake() is called.
+ */
+void mu_time_sleep(void) {
+  #error "Provide a platform-specific implementation for mu_time_sleep()"
+}
+
+/**
+ * @brief Cut short a sleep in progress, or make the next one return at once.
+ */
+void mu_time_wake(void) {
+  #error "Provide a platform-specific implementation for mu_time_wake()"
+}
+
+#endif // #ifdef MU_CAN_SLEEP
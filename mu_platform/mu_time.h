@@ -26,7 +26,7 @@
 #define _MU_TIME_H_
 
 #ifdef __cplusplus
-extern "C";
+extern "C" {
 #endif
 
 // =============================================================================
@@ -43,7 +43,17 @@ extern "C";
   #error "Provide a platform-specific definition for RTC_FREQUENCY"
 #endif
 
-#define MU_TIME_MS_TO_DURATION(ms) (((ms) * 1000) / RTC_FREQUENCY)
+/**
+ * Tick <-> millisecond conversions use a multiply and a shift rather than a
+ * divide: (x * MUL) >> SHIFT, where MUL is derived from SHIFT at compile time.
+ * "Tick and millisecond conversions" in docs/porting_mulib.md explains how to
+ * choose each SHIFT and how to work out the error bounds for your tick rate.
+ * Define MU_TIME_TICKS_TO_MS_SHIFT and MU_TIME_MS_TO_TICKS_SHIFT here and
+ * state the bounds they give.  mu_time_scale.h derives the MULs from them and
+ * fails the build if either SHIFT breaks the rule.
+ */
+#define MU_TIME_FREQUENCY RTC_FREQUENCY
+#include "../demos/shared/mu_time_scale/mu_time_scale.h"
 
 // =============================================================================
 // declarations
@@ -117,15 +127,15 @@ bool mu_time_equals(mu_time_t t1, mu_time_t t2);
 bool mu_time_follows(mu_time_t t1, mu_time_t t2);
 
 /**
- * @brief Convert a duration to milliseconds.
+ * @brief Convert a duration to milliseconds, truncating toward zero.
  *
  * @param dt A duration object
- * @return The duration in seconds
+ * @return The duration in milliseconds
  */
 mu_duration_ms_t mu_time_duration_to_ms(mu_duration_t dt);
 
 /**
- * @brief Convert milliseconds to a duration
+ * @brief Convert milliseconds to a duration, truncating toward zero.
  *
  * @param ms The duration in milliseconds
  * @return A duration object
@@ -150,6 +160,35 @@ MU_FLOAT mu_time_duration_to_s(mu_duration_t dt);
 mu_duration_t mu_time_s_to_duration(MU_FLOAT s);
 #endif
 
+#ifdef MU_CAN_SLEEP
+/**
+ * @brief Sleep until the given time or until mu_time_wake() is called.
+ *
+ * This is intended to be called from the scheduler's idle task with the time
+ * of the earliest scheduled task, so the processor wakes only when there is
+ * work to do.  Returns immediately if `until` has already arrived or if
+ * mu_time_wake() has been called since the last sleep.
+ *
+ * @param until The time at which to wake up.
+ */
+void mu_time_sleep_until(mu_time_t until);
+
+/**
+ * @brief Sleep until mu_time_wake() is called.
+ *
+ * Use this from the idle task when there are no scheduled tasks at all.
+ */
+void mu_time_sleep(void);
+
+/**
+ * @brief Cut short a sleep in progress, or make the next one return at once.
+ *
+ * Call this from interrupt level after mu_sched_isr_task_now() so that the
+ * foreground wakes up to run the newly queued task.
+ */
+void mu_time_wake(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
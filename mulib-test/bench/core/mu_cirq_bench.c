@@ -0,0 +1,114 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_bench_utils.h"
+#include "core/mu_cirq.h"
+#include <stdint.h>
+#include <string.h>
+
+// =============================================================================
+// private types and definitions
+
+// Number of elements moved through the queue in each case.
+#define CIRQ_OPS 1000000
+
+// Queue size in elements.  The capacity is one less.
+#define QUEUE_SIZE 256
+
+// Elements moved per call in the bulk cases.  QUEUE_SIZE isn't a multiple of
+// this, so transfers regularly straddle the wrap.
+#define BATCH 24
+
+// Largest element size measured.
+#define MAX_ELT_SIZE 64
+
+// =============================================================================
+// private declarations
+
+// =============================================================================
+// local storage
+
+static const int s_elt_sizes[] = {1, 4, MAX_ELT_SIZE};
+
+static mu_cirq_t s_cirq;
+
+static uint8_t s_store[QUEUE_SIZE * MAX_ELT_SIZE];
+
+static uint8_t s_src[BATCH * MAX_ELT_SIZE];
+
+static uint8_t s_dst[BATCH * MAX_ELT_SIZE];
+
+// Results are folded into here so the compiler can't discard the timed loops.
+static volatile uint64_t s_sink;
+
+// =============================================================================
+// public code
+
+/**
+ * Measure mu_cirq throughput for 1, 4 and 64 byte elements.  The n column is
+ * the element size and ns/op is the cost per element moved in and out.
+ *
+ * `single` writes and reads one element per call, as a driver does when it
+ * handles one byte or one sample per interrupt.  `bulk` moves BATCH elements
+ * per mu_cirq_write_n() / mu_cirq_read_n() call.  The gap between the two is
+ * the per-call overhead that bulk transfers amortize, and at 64 bytes the
+ * bulk case approaches plain memcpy bandwidth.
+ */
+void mu_cirq_bench() {
+  uint64_t start;
+  uint64_t acc;
+
+  for (int i = 0; i < sizeof(s_elt_sizes) / sizeof(s_elt_sizes[0]); i++) {
+    size_t elt_size = s_elt_sizes[i];
+
+    memset(s_src, i + 1, sizeof(s_src));
+    mu_cirq_init(&s_cirq, s_store, QUEUE_SIZE);
+    acc = 0;
+    start = mu_bench_now_ns();
+    for (int j = 0; j < CIRQ_OPS; j++) {
+      mu_cirq_write_n(&s_cirq, s_src, 1, elt_size);
+      acc += mu_cirq_read_n(&s_cirq, s_dst, 1, elt_size);
+    }
+    mu_bench_report("mu_cirq", "single", elt_size, CIRQ_OPS,
+                    mu_bench_now_ns() - start);
+    s_sink = acc + s_dst[0];
+
+    mu_cirq_init(&s_cirq, s_store, QUEUE_SIZE);
+    acc = 0;
+    start = mu_bench_now_ns();
+    for (int j = 0; j < CIRQ_OPS / BATCH; j++) {
+      mu_cirq_write_n(&s_cirq, s_src, BATCH, elt_size);
+      acc += mu_cirq_read_n(&s_cirq, s_dst, BATCH, elt_size);
+    }
+    mu_bench_report("mu_cirq", "bulk", elt_size, (CIRQ_OPS / BATCH) * BATCH,
+                    mu_bench_now_ns() - start);
+    s_sink = acc + s_dst[0];
+  }
+}
+
+// =============================================================================
+// private code
@@ -0,0 +1,141 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_bench_utils.h"
+#include "mu_mpmcq.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+// =============================================================================
+// private types and definitions
+
+// Items moved through the queue in each case, split among the producers.
+#define MPMCQ_ITEMS 1000000
+
+#define QUEUE_SIZE 1024
+
+// Largest thread count measured.  Counts double from 1 up to this value.
+#define MAX_THREADS 32
+
+// =============================================================================
+// private declarations
+
+static void *producer_fn(void *arg);
+
+static void *consumer_fn(void *arg);
+
+// =============================================================================
+// local storage
+
+static mu_mpmcq_t s_q;
+
+static mu_mpmcq_slot_t s_slots[QUEUE_SIZE];
+
+// items each producer puts in the current case
+static long s_per_producer;
+
+static long s_total;
+
+static atomic_long s_consumed;
+
+// =============================================================================
+// public code
+
+/**
+ * Measure mu_mpmcq throughput under contention.  n is the number of threads:
+ * with one thread, it alternates put and get; otherwise half the threads put
+ * and half get.  ns/op is wall time per item moved, so flat is good, and the
+ * row where it turns up shows where the CAS loops on the shared indices start
+ * to fight.  Thread counts past the host's core count mostly measure the
+ * scheduler, since blocked threads yield.
+ */
+void mu_mpmcq_bench() {
+  pthread_t threads[MAX_THREADS];
+  mu_mpmcq_item_t item;
+  uint64_t start;
+
+  mu_mpmcq_init(&s_q, s_slots, QUEUE_SIZE);
+  start = mu_bench_now_ns();
+  for (long i = 0; i < MPMCQ_ITEMS; i++) {
+    mu_mpmcq_put(&s_q, (mu_mpmcq_item_t)(intptr_t)i);
+    mu_mpmcq_get(&s_q, &item);
+  }
+  mu_bench_report("mu_mpmcq", "put_get", 1, MPMCQ_ITEMS,
+                  mu_bench_now_ns() - start);
+
+  for (int n = 2; n <= MAX_THREADS; n *= 2) {
+    int n_producers = n / 2;
+    int n_consumers = n - n_producers;
+
+    mu_mpmcq_init(&s_q, s_slots, QUEUE_SIZE);
+    s_per_producer = MPMCQ_ITEMS / n_producers;
+    s_total = s_per_producer * n_producers;
+    atomic_store(&s_consumed, 0);
+
+    start = mu_bench_now_ns();
+    for (int i = 0; i < n_consumers; i++) {
+      pthread_create(&threads[i], NULL, consumer_fn, NULL);
+    }
+    for (int i = 0; i < n_producers; i++) {
+      pthread_create(&threads[n_consumers + i], NULL, producer_fn, NULL);
+    }
+    for (int i = 0; i < n; i++) {
+      pthread_join(threads[i], NULL);
+    }
+    mu_bench_report("mu_mpmcq", "put_get", n, s_total,
+                    mu_bench_now_ns() - start);
+  }
+}
+
+// =============================================================================
+// private code
+
+static void *producer_fn(void *arg) {
+  (void)arg;
+  for (long i = 1; i <= s_per_producer; i++) {
+    while (mu_mpmcq_put(&s_q, (mu_mpmcq_item_t)(intptr_t)i) !=
+           MU_MPMCQ_ERR_NONE) {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static void *consumer_fn(void *arg) {
+  mu_mpmcq_item_t item;
+  (void)arg;
+
+  while (atomic_load(&s_consumed) < s_total) {
+    if (mu_mpmcq_get(&s_q, &item) == MU_MPMCQ_ERR_NONE) {
+      atomic_fetch_add(&s_consumed, 1);
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
@@ -0,0 +1,257 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_bench_utils.h"
+#include "core/mu_sched.h"
+
+// =============================================================================
+// private types and definitions
+
+// Largest schedule size to measure.  Sizes double from 1 up to this value.
+#define MAX_TASKS 4096
+
+// Number of hold operations timed at each schedule size.
+#define HOLD_OPS 20000
+
+// Tasks are rescheduled at a random interval in [1, MAX_INCREMENT] ticks.
+#define MAX_INCREMENT 1000
+
+// Number of times each burst is dispatched.
+#define BURST_REPEATS 1000
+
+// Number of times the urgent task is posted at each backlog size.
+#define URGENT_REPEATS 1000
+
+// Number of requests timed at each schedule size in the timeout cases.
+#define TIMEOUT_OPS 100000
+
+// Timeouts are armed this many ticks in the future: mid-schedule, since the
+// background tasks are spread over [0, MAX_INCREMENT).
+#define TIMEOUT_TICKS (MAX_INCREMENT / 2)
+
+// =============================================================================
+// private declarations
+
+static void setup(void);
+
+static void fill(int n_tasks);
+
+static void hold_task_fn(void *ctx, void *arg);
+
+static void burst_task_fn(void *ctx, void *arg);
+
+static void urgent_task_fn(void *ctx, void *arg);
+
+static void timeout_task_fn(void *ctx, void *arg);
+
+static mu_time_t get_time(void);
+
+// =============================================================================
+// local storage
+
+static mu_time_t s_now;
+
+static mu_task_t s_tasks[MAX_TASKS];
+
+static const int s_burst_sizes[] = {1, 10, 200, 1000};
+
+static const int s_backlog_sizes[] = {0, 10, 100, 1000};
+
+static mu_task_t s_urgent_task;
+
+static bool s_urgent_task_ran;
+
+static const int s_populations[] = {0, 10, 100, 1000, 4000};
+
+static mu_task_t s_timeout_task;
+
+// =============================================================================
+// public code
+
+/**
+ * Measure the cost of the schedule's insert and remove-first operations as a
+ * function of the number of queued tasks.
+ *
+ * `fill` times inserting n tasks at random times into an empty schedule.
+ *
+ * `hold` is the classic priority queue benchmark: with n tasks queued, run
+ * the earliest task, which reschedules itself at a random time in the future.
+ * Each hold operation is one remove-first plus one insert, which is the steady
+ * state of a busy scheduler.
+ *
+ * Comparing the ns/op column for different schedule backends shows the value
+ * of n where one backend overtakes the other.
+ *
+ * `burst` measures dispatch throughput when n tasks all come due at the same
+ * instant, dispatched by calling mu_sched_step() until the schedule is empty.
+ *
+ * `urgent` measures the time from posting a task with mu_sched_task_now() to
+ * the moment it runs, when a backlog of n overdue tasks is already waiting.
+ * With strict time ordering this grows with n; with priority classes, a high
+ * priority task should see a flat latency.
+ *
+ * `arm_cancel` models a request with a timeout.  It arms a timeout with
+ * mu_sched_task_at() and cancels it with mu_sched_remove_task() when the
+ * request completes, while n other tasks are pending.  `rearm` pushes back a
+ * timeout that is already queued, so the queued copy has to be found first.
+ * Handling 100k requests/s leaves 10 uSec per request for everything.  With
+ * a linear schedule these costs grow with n.  With a heap index in each task
+ * they should stay nearly flat.
+ */
+void mu_sched_bench() {
+  uint64_t start;
+  uint64_t elapsed;
+
+  for (int n = 1; n <= MAX_TASKS; n *= 2) {
+    setup();
+    start = mu_bench_now_ns();
+    fill(n);
+    mu_bench_report("mu_sched", "fill", n, n, mu_bench_now_ns() - start);
+
+    start = mu_bench_now_ns();
+    for (int i = 0; i < HOLD_OPS; i++) {
+      // advance time to the earliest task and run it.
+      s_now = mu_task_get_time(mu_sched_get_next_task());
+      mu_sched_step();
+    }
+    mu_bench_report("mu_sched", "hold", n, HOLD_OPS, mu_bench_now_ns() - start);
+  }
+
+  for (int i = 0; i < sizeof(s_burst_sizes) / sizeof(s_burst_sizes[0]); i++) {
+    int n = s_burst_sizes[i];
+
+    setup();
+    elapsed = 0;
+    for (int j = 0; j < BURST_REPEATS; j++) {
+      for (int k = 0; k < n; k++) {
+        mu_task_init(&s_tasks[k], burst_task_fn, NULL, "Burst Task");
+        mu_sched_task_at(&s_tasks[k], s_now);
+      }
+      start = mu_bench_now_ns();
+      while (!mu_sched_is_empty()) {
+        mu_sched_step();
+      }
+      elapsed += mu_bench_now_ns() - start;
+    }
+    mu_bench_report("mu_sched", "burst", n, n * BURST_REPEATS, elapsed);
+  }
+
+  for (int i = 0; i < sizeof(s_backlog_sizes) / sizeof(s_backlog_sizes[0]); i++) {
+    int n = s_backlog_sizes[i];
+
+    setup();
+    mu_task_init(&s_urgent_task, urgent_task_fn, NULL, "Urgent Task");
+    elapsed = 0;
+    for (int j = 0; j < URGENT_REPEATS; j++) {
+      // n low priority tasks, each already overdue
+      s_now = n;
+      for (int k = 0; k < n; k++) {
+        mu_task_init(&s_tasks[k], burst_task_fn, NULL, "Backlog Task");
+        mu_sched_task_at(&s_tasks[k], k);
+      }
+      s_urgent_task_ran = false;
+      start = mu_bench_now_ns();
+      mu_sched_task_now(&s_urgent_task);
+      while (!s_urgent_task_ran) {
+        mu_sched_step();
+      }
+      elapsed += mu_bench_now_ns() - start;
+      mu_sched_reset();
+    }
+    mu_bench_report("mu_sched", "urgent", n, URGENT_REPEATS, elapsed);
+  }
+
+  for (int i = 0; i < sizeof(s_populations) / sizeof(s_populations[0]); i++) {
+    int n = s_populations[i];
+
+    setup();
+    fill(n);
+    mu_task_init(&s_timeout_task, timeout_task_fn, NULL, "Timeout Task");
+
+    start = mu_bench_now_ns();
+    for (int j = 0; j < TIMEOUT_OPS; j++) {
+      mu_sched_task_at(&s_timeout_task, mu_time_offset(s_now, TIMEOUT_TICKS));
+      mu_sched_remove_task(&s_timeout_task);
+    }
+    mu_bench_report("mu_sched", "arm_cancel", n, TIMEOUT_OPS,
+                    mu_bench_now_ns() - start);
+
+    mu_sched_task_at(&s_timeout_task, mu_time_offset(s_now, TIMEOUT_TICKS));
+    start = mu_bench_now_ns();
+    for (int j = 0; j < TIMEOUT_OPS; j++) {
+      mu_sched_task_at(&s_timeout_task,
+                       mu_time_offset(s_now, TIMEOUT_TICKS + (j & 1)));
+    }
+    mu_bench_report("mu_sched", "rearm", n, TIMEOUT_OPS,
+                    mu_bench_now_ns() - start);
+  }
+  mu_sched_reset();
+}
+
+// =============================================================================
+// private code
+
+static void setup(void) {
+  mu_bench_random_reset();
+  mu_sched_init();
+  s_now = 0;
+  mu_sched_set_clock_source(get_time);
+}
+
+static void fill(int n_tasks) {
+  for (int i = 0; i < n_tasks; i++) {
+    mu_task_t *task = &s_tasks[i];
+    mu_task_init(task, hold_task_fn, task, "Hold Task");
+    mu_sched_task_at(task, mu_time_offset(s_now, mu_bench_random(MAX_INCREMENT)));
+  }
+}
+
+static void hold_task_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+  mu_sched_reschedule_in(1 + mu_bench_random(MAX_INCREMENT));
+}
+
+static void burst_task_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+}
+
+static void urgent_task_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+  s_urgent_task_ran = true;
+}
+
+static void timeout_task_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+}
+
+static mu_time_t get_time(void) {
+  return s_now;
+}
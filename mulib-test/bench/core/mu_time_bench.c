@@ -0,0 +1,167 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_bench_utils.h"
+#include "mu_time.h"
+#include "core/mu_sched.h"
+#include "mu_time_scale/mu_time_scale.h"
+
+// =============================================================================
+// private types and definitions
+
+// Number of operations timed in each case.
+#define TIME_OPS 1000000
+
+// The conversion cases mirror the 32768 Hz MSP430 port: ms to ticks is
+// ms * 32768 / 1000, or a multiply and shift with the port's SHIFT of 26.
+#define RTC_HZ 32768
+#define MS_TO_TICKS_SHIFT 26
+#define MS_TO_TICKS_MUL MU_TIME_RECIPROCAL(RTC_HZ, 1000, MS_TO_TICKS_SHIFT)
+
+#if !MU_TIME_SHIFT_OK_PP_(RTC_HZ, 1000, MS_TO_TICKS_SHIFT)
+  #error "MS_TO_TICKS_SHIFT breaks the rule in docs/porting_mulib.md"
+#endif
+
+// =============================================================================
+// private declarations
+
+static void task_fn(void *ctx, void *arg);
+
+// =============================================================================
+// local storage
+
+static mu_task_t s_task;
+
+// Results are folded into here so the compiler can't discard the timed loops.
+static volatile uint64_t s_sink;
+
+// Read through a volatile so the divide isn't strength-reduced, as on a
+// target that calls a library routine for 64-bit division.
+static volatile uint64_t s_ms_per_second = 1000;
+
+// =============================================================================
+// public code
+
+/**
+ * Measure the platform time functions that sit in the scheduler's hot path.
+ *
+ * `now` is the cost of mu_time_now().  `offset_compare` is one
+ * mu_time_offset() plus one mu_time_precedes(), the pair mu_sched uses to
+ * order and test tasks.  `ms_to_duration` is one mu_time_ms_to_duration(),
+ * as used by MU_TIME_MS_TO_DURATION-style timeouts.
+ *
+ * `conv_div`, `conv_float` and `conv_mulshift` compare three ways a tick-based
+ * port can turn milliseconds into ticks: a 64-bit divide, a round trip
+ * through MU_FLOAT, and the multiply-shift the ports use.
+ *
+ * `step_idle` is one mu_sched_step() with the real clock and nothing due: a
+ * clock read, a comparison against the earliest task, and a return.
+ */
+void mu_time_bench() {
+  uint64_t start;
+  uint64_t acc;
+  mu_time_t t;
+  mu_time_t ref;
+
+  mu_time_init();
+
+  acc = 0;
+  start = mu_bench_now_ns();
+  for (int i = 0; i < TIME_OPS; i++) {
+    acc += (uint64_t)mu_time_now();
+  }
+  mu_bench_report("mu_time", "now", 1, TIME_OPS, mu_bench_now_ns() - start);
+  s_sink = acc;
+
+  acc = 0;
+  t = mu_time_now();
+  ref = mu_time_offset(t, TIME_OPS / 2);
+  start = mu_bench_now_ns();
+  for (int i = 0; i < TIME_OPS; i++) {
+    t = mu_time_offset(t, 1);
+    acc += mu_time_precedes(t, ref);
+  }
+  mu_bench_report("mu_time", "offset_compare", 1, TIME_OPS,
+                  mu_bench_now_ns() - start);
+  s_sink = acc;
+
+  acc = 0;
+  start = mu_bench_now_ns();
+  for (int i = 0; i < TIME_OPS; i++) {
+    acc += (uint64_t)mu_time_ms_to_duration(i & 0xffff);
+  }
+  mu_bench_report("mu_time", "ms_to_duration", 1, TIME_OPS,
+                  mu_bench_now_ns() - start);
+  s_sink = acc;
+
+  acc = 0;
+  start = mu_bench_now_ns();
+  for (int i = 0; i < TIME_OPS; i++) {
+    acc += (uint64_t)i * RTC_HZ / s_ms_per_second;
+  }
+  mu_bench_report("mu_time", "conv_div", 1, TIME_OPS,
+                  mu_bench_now_ns() - start);
+  s_sink = acc;
+
+  acc = 0;
+  start = mu_bench_now_ns();
+  for (int i = 0; i < TIME_OPS; i++) {
+    acc += (uint64_t)((mu_float_t)i * RTC_HZ / 1000.0);
+  }
+  mu_bench_report("mu_time", "conv_float", 1, TIME_OPS,
+                  mu_bench_now_ns() - start);
+  s_sink = acc;
+
+  acc = 0;
+  start = mu_bench_now_ns();
+  for (int i = 0; i < TIME_OPS; i++) {
+    acc += MU_TIME_SCALE(i, MS_TO_TICKS_MUL, MS_TO_TICKS_SHIFT);
+  }
+  mu_bench_report("mu_time", "conv_mulshift", 1, TIME_OPS,
+                  mu_bench_now_ns() - start);
+  s_sink = acc;
+
+  mu_sched_init();
+  mu_sched_set_clock_source(mu_time_now);
+  mu_task_init(&s_task, task_fn, NULL, "Future Task");
+  mu_sched_task_in(&s_task, mu_time_ms_to_duration(3600000));
+  start = mu_bench_now_ns();
+  for (int i = 0; i < TIME_OPS; i++) {
+    mu_sched_step();
+  }
+  mu_bench_report("mu_time", "step_idle", 1, TIME_OPS,
+                  mu_bench_now_ns() - start);
+  mu_sched_reset();
+}
+
+// =============================================================================
+// private code
+
+static void task_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+}
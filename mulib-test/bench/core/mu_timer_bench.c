@@ -0,0 +1,273 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_bench_utils.h"
+#include "core/mu_timer.h"
+#include "core/mu_sched.h"
+#include "mu_cyclic/mu_cyclic.h"
+
+// =============================================================================
+// private types and definitions
+
+// Largest number of background (keep-alive) timers to measure.
+#define MAX_TIMERS 5000
+
+// Number of start / stop pairs timed at each background population.
+#define START_STOP_OPS 100000
+
+// Timer durations are chosen at random in [1, MAX_DURATION] ticks.
+#define MAX_DURATION 10000
+
+// A rate group is one task at each of these periods (1 tick = 1 mSec).  The
+// hyperperiod is their least common multiple.
+#define HYPERPERIOD 1000
+
+// Number of times a set of rate groups is started and stopped.
+#define PERIODIC_START_REPEATS 1000
+
+// Number of hyperperiods run at each population.
+#define PERIODIC_HYPERPERIODS 100
+
+// A cyclic table holds at most MU_CYCLIC_MAX_ENTRIES entries, so rate groups
+// are split across tables of up to this many groups each.
+#define GROUPS_PER_TABLE 10
+
+#define MAX_TABLES 10
+
+// The minor frame is the shortest rate group period, 10 ticks.
+#define MINOR_FRAMES (HYPERPERIOD / 10)
+
+// =============================================================================
+// private declarations
+
+static void setup(void);
+
+static void start_background_timers(int n_timers);
+
+static void start_rate_groups(int n_groups);
+
+static void stop_rate_groups(int n_groups);
+
+static int start_cyclic_tables(int n_groups);
+
+static void stop_cyclic_tables(int n_tables);
+
+static void task_fn(void *ctx, void *arg);
+
+static mu_time_t get_time(void);
+
+// =============================================================================
+// local storage
+
+static const int s_populations[] = {0, 10, 100, 1000, MAX_TIMERS};
+
+static const mu_duration_t s_rate_group[] = {10, 50, HYPERPERIOD};
+
+#define RATE_GROUP_SIZE (sizeof(s_rate_group) / sizeof(s_rate_group[0]))
+
+static const int s_group_counts[] = {1, 10, 100};
+
+static mu_time_t s_now;
+
+static unsigned long s_dispatch_count;
+
+static mu_task_t s_task;
+
+static mu_timer_t s_timers[MAX_TIMERS];
+
+static mu_timer_t s_probe_timer;
+
+static mu_cyclic_entry_t s_cyclic_table[GROUPS_PER_TABLE * 3];
+
+static mu_cyclic_t s_cyclics[MAX_TABLES];
+
+static uint32_t s_cyclic_masks[MAX_TABLES][MINOR_FRAMES];
+
+// =============================================================================
+// public code
+
+/**
+ * Measure the cost of mu_timer_start() followed by mu_timer_stop() while n
+ * periodic keep-alive timers are running, for a total of START_STOP_OPS pairs.
+ *
+ * When timers sit directly on the schedule, each start is an ordered insert
+ * and each stop is a search, so the cost grows with n.  A timing wheel should
+ * keep the cost flat.
+ *
+ * `periodic_start` and `periodic_run` measure a fixed set of periodic tasks:
+ * n rate groups, each with one task at 10, 50 and 1000 ticks.
+ * `periodic_start` times starting every timer (ns per timer).
+ * `periodic_run` times dispatching them over 100 hyperperiods (ns per
+ * dispatch), including the reinsertion that mu_timer does each period.
+ *
+ * `cyclic_start` and `cyclic_run` measure the same rate groups run from
+ * mu_cyclic tables of up to 10 groups each.  `cyclic_start` times
+ * mu_cyclic_init(), mu_cyclic_start() and mu_cyclic_stop() (ns per entry).
+ * `cyclic_run` times the same 100 hyperperiods (ns per entry called), with
+ * one reinsertion per table per minor frame.
+ */
+void mu_timer_bench() {
+  uint64_t start;
+
+  for (int i = 0; i < sizeof(s_populations) / sizeof(s_populations[0]); i++) {
+    int n = s_populations[i];
+
+    setup();
+    start_background_timers(n);
+    mu_timer_periodic(&s_probe_timer, &s_task);
+
+    start = mu_bench_now_ns();
+    for (int j = 0; j < START_STOP_OPS; j++) {
+      mu_timer_start(&s_probe_timer, 1 + mu_bench_random(MAX_DURATION));
+      mu_timer_stop(&s_probe_timer);
+    }
+    mu_bench_report("mu_timer", "start_stop", n, START_STOP_OPS,
+                    mu_bench_now_ns() - start);
+
+    for (int j = 0; j < n; j++) {
+      mu_timer_stop(&s_timers[j]);
+    }
+  }
+
+  for (int i = 0; i < sizeof(s_group_counts) / sizeof(s_group_counts[0]); i++) {
+    int n = s_group_counts[i];
+    int n_tables;
+    mu_time_t end;
+
+    setup();
+    start = mu_bench_now_ns();
+    for (int j = 0; j < PERIODIC_START_REPEATS; j++) {
+      start_rate_groups(n);
+      stop_rate_groups(n);
+    }
+    mu_bench_report("mu_timer", "periodic_start", n * RATE_GROUP_SIZE,
+                    n * RATE_GROUP_SIZE * PERIODIC_START_REPEATS,
+                    mu_bench_now_ns() - start);
+
+    setup();
+    start_rate_groups(n);
+    end = mu_time_offset(s_now, PERIODIC_HYPERPERIODS * HYPERPERIOD);
+    s_dispatch_count = 0;
+    start = mu_bench_now_ns();
+    while (mu_time_precedes(s_now, end)) {
+      s_now = mu_task_get_time(mu_sched_get_next_task());
+      mu_sched_step();
+    }
+    mu_bench_report("mu_timer", "periodic_run", n * RATE_GROUP_SIZE,
+                    s_dispatch_count, mu_bench_now_ns() - start);
+    stop_rate_groups(n);
+
+    setup();
+    start = mu_bench_now_ns();
+    for (int j = 0; j < PERIODIC_START_REPEATS; j++) {
+      stop_cyclic_tables(start_cyclic_tables(n));
+    }
+    mu_bench_report("mu_cyclic", "cyclic_start", n * RATE_GROUP_SIZE,
+                    n * RATE_GROUP_SIZE * PERIODIC_START_REPEATS,
+                    mu_bench_now_ns() - start);
+
+    setup();
+    n_tables = start_cyclic_tables(n);
+    end = mu_time_offset(s_now, PERIODIC_HYPERPERIODS * HYPERPERIOD);
+    s_dispatch_count = 0;
+    start = mu_bench_now_ns();
+    while (mu_time_precedes(s_now, end)) {
+      s_now = mu_task_get_time(mu_sched_get_next_task());
+      mu_sched_step();
+    }
+    mu_bench_report("mu_cyclic", "cyclic_run", n * RATE_GROUP_SIZE,
+                    s_dispatch_count, mu_bench_now_ns() - start);
+    stop_cyclic_tables(n_tables);
+  }
+  mu_sched_reset();
+}
+
+// =============================================================================
+// private code
+
+static void setup(void) {
+  mu_bench_random_reset();
+  mu_sched_init();
+  s_now = 0;
+  mu_sched_set_clock_source(get_time);
+  mu_task_init(&s_task, task_fn, &s_task, "Timed Task");
+  for (int i = 0; i < GROUPS_PER_TABLE * RATE_GROUP_SIZE; i++) {
+    s_cyclic_table[i] = (mu_cyclic_entry_t)MU_CYCLIC_ENTRY(
+        "Rate Group", task_fn, NULL, s_rate_group[i % RATE_GROUP_SIZE]);
+  }
+}
+
+static void start_background_timers(int n_timers) {
+  for (int i = 0; i < n_timers; i++) {
+    mu_timer_periodic(&s_timers[i], &s_task);
+    mu_timer_start(&s_timers[i], 1 + mu_bench_random(MAX_DURATION));
+  }
+}
+
+static void start_rate_groups(int n_groups) {
+  for (int i = 0; i < n_groups * RATE_GROUP_SIZE; i++) {
+    mu_timer_periodic(&s_timers[i], &s_task);
+    mu_timer_start(&s_timers[i], s_rate_group[i % RATE_GROUP_SIZE]);
+  }
+}
+
+static void stop_rate_groups(int n_groups) {
+  for (int i = 0; i < n_groups * RATE_GROUP_SIZE; i++) {
+    mu_timer_stop(&s_timers[i]);
+  }
+}
+
+// Start enough tables to hold n_groups rate groups, and return how many.
+static int start_cyclic_tables(int n_groups) {
+  int n_tables = 0;
+
+  for (int left = n_groups; left > 0; left -= GROUPS_PER_TABLE) {
+    int groups = (left < GROUPS_PER_TABLE) ? left : GROUPS_PER_TABLE;
+    mu_cyclic_init(&s_cyclics[n_tables], s_cyclic_table,
+                   groups * RATE_GROUP_SIZE, s_cyclic_masks[n_tables],
+                   MINOR_FRAMES);
+    mu_cyclic_start(&s_cyclics[n_tables], s_now);
+    n_tables += 1;
+  }
+  return n_tables;
+}
+
+static void stop_cyclic_tables(int n_tables) {
+  for (int i = 0; i < n_tables; i++) {
+    mu_cyclic_stop(&s_cyclics[i]);
+  }
+}
+
+static void task_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+  s_dispatch_count += 1;
+}
+
+static mu_time_t get_time(void) {
+  return s_now;
+}
@@ -0,0 +1,63 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+ // =============================================================================
+ // includes
+
+#include <stdio.h>
+#include "mu_bench_utils.h"
+
+// =============================================================================
+// types and definitions
+
+// =============================================================================
+// declarations
+
+void mu_cirq_bench();
+void mu_mpmcq_bench();
+void mu_sched_bench();
+void mu_time_bench();
+void mu_timer_bench();
+
+// =============================================================================
+// public code
+
+int main() {
+
+  printf("\r\nstarting mu_bench...\r\n");
+  printf("%-24s %-16s %8s %10s %10s\r\n", "bench", "label", "n", "ops", "ns/op");
+
+  mu_cirq_bench();
+  mu_mpmcq_bench();
+  mu_sched_bench();
+  mu_time_bench();
+  mu_timer_bench();
+
+  printf("ending mu_bench\r\n");
+
+  return 0;
+}
+
+// =============================================================================
+// private code
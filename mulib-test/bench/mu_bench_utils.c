@@ -0,0 +1,76 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_bench_utils.h"
+#include <stdio.h>
+#include <time.h>
+
+// =============================================================================
+// local types and definitions
+
+#define RAND_SEED ((uint32_t)123456789)
+#define RAND_A ((uint32_t)1103515245)
+#define RAND_C ((uint32_t)12345)
+
+// =============================================================================
+// local (forward) declarations
+
+// =============================================================================
+// local storage
+
+static uint32_t s_random_seed = RAND_SEED;
+
+// =============================================================================
+// public code
+
+uint64_t mu_bench_now_ns(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+void mu_bench_report(const char *bench,
+                     const char *label,
+                     unsigned long n,
+                     unsigned long ops,
+                     uint64_t elapsed_ns) {
+  double ns_per_op = (ops == 0) ? 0.0 : (double)elapsed_ns / ops;
+  printf("%-24s %-16s %8lu %10lu %10.1f\r\n", bench, label, n, ops, ns_per_op);
+  fflush(stdout);
+}
+
+uint32_t mu_bench_random(uint32_t max) {
+  s_random_seed = (uint32_t)((RAND_A * s_random_seed + RAND_C) & 0x7fffffff);
+  return (max == 0) ? 0 : s_random_seed % max;
+}
+
+void mu_bench_random_reset(void) {
+  s_random_seed = RAND_SEED;
+}
+
+// =============================================================================
+// local (static) code
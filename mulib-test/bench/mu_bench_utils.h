@@ -0,0 +1,85 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _MU_BENCH_UTILS_H_
+#define _MU_BENCH_UTILS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// includes
+
+#include <stdint.h>
+
+// =============================================================================
+// types and definitions
+
+// =============================================================================
+// declarations
+
+/**
+ * @brief Return a monotonic wall-clock timestamp in nanoseconds.
+ *
+ * Benchmarks measure elapsed time with the host's clock rather than with
+ * mu_time_now(), since the latter may be stubbed or coarse on the test host.
+ */
+uint64_t mu_bench_now_ns(void);
+
+/**
+ * @brief Print one line of benchmark results.
+ *
+ * Output is whitespace separated so it can be fed directly to a plotting
+ * program: `<bench> <label> <n> <ops> <ns/op>`.
+ *
+ * @param bench The name of the benchmark, e.g. "mu_sched_hold".
+ * @param label A short description of the variant being measured.
+ * @param n The problem size (e.g. number of queued tasks).
+ * @param ops The number of operations that were timed.
+ * @param elapsed_ns The elapsed time for all ops, in nanoseconds.
+ */
+void mu_bench_report(const char *bench,
+                     const char *label,
+                     unsigned long n,
+                     unsigned long ops,
+                     uint64_t elapsed_ns);
+
+/**
+ * @brief Return a pseudo-random number in the range [0, max).
+ *
+ * A simple LCG so that runs are reproducible from one host to the next.
+ */
+uint32_t mu_bench_random(uint32_t max);
+
+/**
+ * @brief Reset the pseudo-random number generator to its initial seed.
+ */
+void mu_bench_random_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _MU_BENCH_UTILS_H_
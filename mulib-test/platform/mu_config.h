@@ -46,7 +46,7 @@ extern "C" {
 
 #define MU_LOG_ENABLED 1
 // #define MU_TASK_PROFILING
-// #define MU_CAN_SLEEP
+#define MU_CAN_SLEEP
 
 /**
  * Define the number of tasks that can be scheduled at interrupt level between
@@ -62,8 +62,12 @@ extern "C" {
 // #define MU_FLOAT float
 #define MU_FLOAT double
 
-typedef uint32_t mu_time_t;
-typedef int32_t mu_duration_t;
+/**
+ * Time is nanoseconds of CLOCK_MONOTONIC.  At 64 bits it won't roll over for
+ * 292 years, and comparisons still use signed differences in case it does.
+ */
+typedef uint64_t mu_time_t;
+typedef int64_t mu_duration_t;
 typedef int32_t mu_duration_ms_t;
 
 // =============================================================================
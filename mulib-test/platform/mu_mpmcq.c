@@ -0,0 +1,133 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_mpmcq.h"
+
+#include <stdint.h>
+
+// =============================================================================
+// private types and definitions
+
+// =============================================================================
+// private declarations
+
+// =============================================================================
+// local storage
+
+// =============================================================================
+// public code
+
+mu_mpmcq_err_t mu_mpmcq_init(mu_mpmcq_t *q, mu_mpmcq_slot_t *slots, size_t size) {
+  if (size == 0 || (size & (size - 1)) != 0) {
+    return MU_MPMCQ_ERR_SIZE;
+  }
+  q->slots = slots;
+  q->mask = size - 1;
+  // slot i is ready for the producer of lap 0 at position i
+  for (size_t i = 0; i < size; i++) {
+    atomic_store_explicit(&slots[i].seq, i, memory_order_relaxed);
+    slots[i].item = NULL;
+  }
+  atomic_store_explicit(&q->put_index, 0, memory_order_relaxed);
+  atomic_store_explicit(&q->get_index, 0, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  return MU_MPMCQ_ERR_NONE;
+}
+
+size_t mu_mpmcq_capacity(mu_mpmcq_t *q) { return q->mask + 1; }
+
+size_t mu_mpmcq_count(mu_mpmcq_t *q) {
+  size_t get = atomic_load_explicit(&q->get_index, memory_order_acquire);
+  size_t put = atomic_load_explicit(&q->put_index, memory_order_acquire);
+  size_t count = put - get;
+  // The two loads aren't a snapshot.  get is read first and put only grows,
+  // so a racing update can only make count too large, never wrap it below
+  // zero.  Too large means the queue is close to full, so clamp to capacity.
+  return (count > q->mask + 1) ? q->mask + 1 : count;
+}
+
+mu_mpmcq_err_t mu_mpmcq_put(mu_mpmcq_t *q, mu_mpmcq_item_t item) {
+  size_t pos = atomic_load_explicit(&q->put_index, memory_order_relaxed);
+
+  for (;;) {
+    mu_mpmcq_slot_t *slot = &q->slots[pos & q->mask];
+    size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+    if (diff == 0) {
+      // the slot is free for this lap: try to claim it
+      if (atomic_compare_exchange_weak_explicit(&q->put_index, &pos, pos + 1,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed)) {
+        slot->item = item;
+        // publish: the slot now belongs to the consumer at pos
+        atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+        return MU_MPMCQ_ERR_NONE;
+      }
+      // lost the race: pos was reloaded by the failed CAS
+    } else if (diff < 0) {
+      // the consumer of the previous lap hasn't freed the slot
+      return MU_MPMCQ_ERR_FULL;
+    } else {
+      // another producer claimed the slot: catch up
+      pos = atomic_load_explicit(&q->put_index, memory_order_relaxed);
+    }
+  }
+}
+
+mu_mpmcq_err_t mu_mpmcq_get(mu_mpmcq_t *q, mu_mpmcq_item_t *item) {
+  size_t pos = atomic_load_explicit(&q->get_index, memory_order_relaxed);
+
+  for (;;) {
+    mu_mpmcq_slot_t *slot = &q->slots[pos & q->mask];
+    size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+    if (diff == 0) {
+      // the slot holds the item for pos: try to claim it
+      if (atomic_compare_exchange_weak_explicit(&q->get_index, &pos, pos + 1,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed)) {
+        *item = slot->item;
+        // free the slot for the producer of the next lap
+        atomic_store_explicit(&slot->seq, pos + q->mask + 1,
+                              memory_order_release);
+        return MU_MPMCQ_ERR_NONE;
+      }
+    } else if (diff < 0) {
+      // the producer for pos hasn't published yet
+      *item = NULL;
+      return MU_MPMCQ_ERR_EMPTY;
+    } else {
+      // another consumer claimed the slot: catch up
+      pos = atomic_load_explicit(&q->get_index, memory_order_relaxed);
+    }
+  }
+}
+
+// =============================================================================
+// private code
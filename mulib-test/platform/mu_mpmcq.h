@@ -0,0 +1,144 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * mu_mpmcq: a bounded, lock-free multi-producer / multi-consumer queue for
+ * host builds.
+ *
+ * Any number of threads may call mu_mpmcq_put() and mu_mpmcq_get() at once.
+ * The caller supplies the slot storage, so there is no malloc.  Neither call
+ * blocks: a put into a full queue or a get from an empty one returns an error
+ * at once, and the caller decides whether to retry, yield or drop.
+ *
+ * This is Dmitry Vyukov's bounded queue.  Each slot carries a sequence number
+ * that says whether it is ready for the producer or the consumer of a given
+ * lap, so producers contend only on the put index, consumers only on the get
+ * index, and a producer and consumer meet only at a slot's sequence number.
+ *
+ * It needs C11 atomics, which is why it lives with the host platform rather
+ * than in mulib/core.  On a microcontroller use mu_spscq between an ISR and
+ * the foreground instead.
+ */
+
+#ifndef _MU_MPMCQ_H_
+#define _MU_MPMCQ_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// includes
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+// =============================================================================
+// types and definitions
+
+/**
+ * The put and get indices each get a cache line of their own, so producers and
+ * consumers don't invalidate each other's index on every operation.
+ */
+#ifndef MU_MPMCQ_CACHE_LINE
+#define MU_MPMCQ_CACHE_LINE 64
+#endif
+
+typedef void *mu_mpmcq_item_t;
+
+typedef enum {
+  MU_MPMCQ_ERR_NONE,
+  MU_MPMCQ_ERR_EMPTY,
+  MU_MPMCQ_ERR_FULL,
+  MU_MPMCQ_ERR_SIZE,
+} mu_mpmcq_err_t;
+
+/**
+ * @brief One slot of queue storage.  Supply an array of these to
+ * mu_mpmcq_init().
+ */
+typedef struct {
+  atomic_size_t seq;
+  mu_mpmcq_item_t item;
+} mu_mpmcq_slot_t;
+
+typedef struct {
+  alignas(MU_MPMCQ_CACHE_LINE) atomic_size_t put_index;
+  alignas(MU_MPMCQ_CACHE_LINE) atomic_size_t get_index;
+  alignas(MU_MPMCQ_CACHE_LINE) mu_mpmcq_slot_t *slots;
+  size_t mask;
+} mu_mpmcq_t;
+
+// =============================================================================
+// declarations
+
+/**
+ * @brief Initialize a queue over caller-supplied slots.
+ *
+ * Not thread safe: finish initializing before any thread uses the queue.
+ *
+ * @param q The queue.
+ * @param slots Storage for `size` slots.
+ * @param size The number of slots.  Must be a power of two.  All `size` slots
+ *        are usable.
+ * @return MU_MPMCQ_ERR_SIZE if size isn't a power of two, else
+ *         MU_MPMCQ_ERR_NONE.
+ */
+mu_mpmcq_err_t mu_mpmcq_init(mu_mpmcq_t *q, mu_mpmcq_slot_t *slots, size_t size);
+
+/**
+ * @brief Return the number of items the queue can hold.
+ */
+size_t mu_mpmcq_capacity(mu_mpmcq_t *q);
+
+/**
+ * @brief Return the number of items in the queue.
+ *
+ * With other threads running this is only an estimate, good for diagnostics
+ * but not for deciding whether a put or get will succeed.  It may run high,
+ * but never above mu_mpmcq_capacity().
+ */
+size_t mu_mpmcq_count(mu_mpmcq_t *q);
+
+/**
+ * @brief Add an item to the tail of the queue.
+ *
+ * @return MU_MPMCQ_ERR_FULL if the queue was full, else MU_MPMCQ_ERR_NONE.
+ */
+mu_mpmcq_err_t mu_mpmcq_put(mu_mpmcq_t *q, mu_mpmcq_item_t item);
+
+/**
+ * @brief Remove the item at the head of the queue.
+ *
+ * @param item Receives the item, or NULL if the queue was empty.
+ * @return MU_MPMCQ_ERR_EMPTY if the queue was empty, else MU_MPMCQ_ERR_NONE.
+ */
+mu_mpmcq_err_t mu_mpmcq_get(mu_mpmcq_t *q, mu_mpmcq_item_t *item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #ifndef _MU_MPMCQ_H_
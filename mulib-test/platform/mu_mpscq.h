@@ -0,0 +1,176 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * mu_mpscq: a bounded, lock-free multi-producer / single-consumer queue for
+ * posting from interrupt context (threads, on the host) to the foreground.
+ *
+ * This is the queue proposed in DevNotes to replace the ring behind
+ * mu_sched_isr_task_now().  Any number of producers may call mu_mpscq_put()
+ * at once, and none of them masks interrupts.  One consumer, which would be
+ * mu_sched_step(), calls mu_mpscq_get().
+ *
+ * It is mu_mpmcq's sequence-numbered slots with the consumer side simplified:
+ * with a single consumer, the get index needs no compare-and-swap.  A
+ * producer that is preempted between claiming a slot and publishing it
+ * stalls the consumer at that slot: mu_mpscq_get() reports the queue empty
+ * until the slot is published, then carries on in order.  No item is lost or
+ * reordered.
+ *
+ * A put into a full queue fails at once and is counted, since an ISR can't
+ * wait.  The consumer also records the deepest the queue has been.
+ *
+ * It needs C11 atomics, which is why it lives with the host platform.  mulib
+ * core's mu_sched.c isn't in this tree, so mu_sched_isr_task_now() can't be
+ * switched over here.  On a core without compare-and-swap, a port would
+ * supply one that masks interrupts around the compare and store only.
+ */
+
+#ifndef _MU_MPSCQ_H_
+#define _MU_MPSCQ_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// includes
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+// =============================================================================
+// types and definitions
+
+/**
+ * The put index and the consumer's state each get a cache line of their own,
+ * so producers don't invalidate the consumer's index on every put.
+ */
+#ifndef MU_MPSCQ_CACHE_LINE
+#define MU_MPSCQ_CACHE_LINE 64
+#endif
+
+typedef void *mu_mpscq_item_t;
+
+typedef enum {
+  MU_MPSCQ_ERR_NONE,
+  MU_MPSCQ_ERR_EMPTY,
+  MU_MPSCQ_ERR_FULL,
+  MU_MPSCQ_ERR_SIZE,
+} mu_mpscq_err_t;
+
+/**
+ * @brief One slot of queue storage.  Supply an array of these to
+ * mu_mpscq_init().
+ */
+typedef struct {
+  atomic_size_t seq;
+  mu_mpscq_item_t item;
+} mu_mpscq_slot_t;
+
+typedef struct {
+  // shared by the producers
+  alignas(MU_MPSCQ_CACHE_LINE) atomic_size_t put_index;
+  atomic_ulong overflow_count;  // puts that found the queue full
+  // written by the consumer only
+  alignas(MU_MPSCQ_CACHE_LINE) atomic_size_t get_index;
+  size_t high_water;
+  // fixed after mu_mpscq_init()
+  mu_mpscq_slot_t *slots;
+  size_t mask;
+} mu_mpscq_t;
+
+// =============================================================================
+// declarations
+
+/**
+ * @brief Initialize a queue over caller-supplied slots.
+ *
+ * Not thread safe: finish initializing before any thread uses the queue.
+ *
+ * @param q The queue.
+ * @param slots Storage for `size` slots.
+ * @param size The number of slots.  Must be a power of two.  All `size` slots
+ *        are usable.
+ * @return MU_MPSCQ_ERR_SIZE if size isn't a power of two, else
+ *         MU_MPSCQ_ERR_NONE.
+ */
+mu_mpscq_err_t mu_mpscq_init(mu_mpscq_t *q, mu_mpscq_slot_t *slots, size_t size);
+
+/**
+ * @brief Return the number of items the queue can hold.
+ */
+size_t mu_mpscq_capacity(mu_mpscq_t *q);
+
+/**
+ * @brief Return the number of items in the queue.
+ *
+ * With producers running this is only an estimate, good for diagnostics but
+ * not for deciding whether a put will succeed.  It never exceeds
+ * mu_mpscq_capacity().
+ */
+size_t mu_mpscq_count(mu_mpscq_t *q);
+
+/**
+ * @brief Add an item to the tail of the queue.  Safe from any producer.
+ *
+ * @return MU_MPSCQ_ERR_FULL if the queue was full, in which case the item is
+ *         dropped and counted in mu_mpscq_overflow_count(), else
+ *         MU_MPSCQ_ERR_NONE.
+ */
+mu_mpscq_err_t mu_mpscq_put(mu_mpscq_t *q, mu_mpscq_item_t item);
+
+/**
+ * @brief Remove the item at the head of the queue.  Consumer only.
+ *
+ * @param item Receives the item, or NULL if the queue was empty.
+ * @return MU_MPSCQ_ERR_EMPTY if the queue was empty, or its head hasn't been
+ *         published yet, else MU_MPSCQ_ERR_NONE.
+ */
+mu_mpscq_err_t mu_mpscq_get(mu_mpscq_t *q, mu_mpscq_item_t *item);
+
+/**
+ * @brief Return the number of puts that found the queue full.
+ */
+unsigned long mu_mpscq_overflow_count(mu_mpscq_t *q);
+
+/**
+ * @brief Return the most items the consumer has found in the queue.
+ *
+ * Sampled by each successful mu_mpscq_get(), counting the item it removes.
+ * Never exceeds mu_mpscq_capacity().  Consumer only.
+ */
+size_t mu_mpscq_high_water(mu_mpscq_t *q);
+
+/**
+ * @brief Clear the overflow count and the high water mark.  Consumer only.
+ */
+void mu_mpscq_reset_stats(mu_mpscq_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #ifndef _MU_MPSCQ_H_
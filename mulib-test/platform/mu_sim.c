@@ -0,0 +1,202 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_sim.h"
+
+#include "mu_time.h"
+#include "core/mu_sched.h"
+#include <stdio.h>
+#include <time.h>
+
+// =============================================================================
+// private types and definitions
+
+// =============================================================================
+// private declarations
+
+static mu_time_t get_time(void);
+
+static bool fire_next_event(void);
+
+static bool next_deadline(mu_time_t *deadline);
+
+static uint64_t wall_now_ns(void);
+
+// =============================================================================
+// local storage
+
+static mu_time_t s_now;
+
+static mu_sim_event_t *s_events;
+
+static unsigned long s_step_count;
+
+static unsigned long s_jump_count;
+
+static double s_sim_s;
+
+static uint64_t s_wall_ns;
+
+// =============================================================================
+// public code
+
+void mu_sim_init(mu_time_t start) {
+  s_now = start;
+  s_events = NULL;
+  s_step_count = 0;
+  s_jump_count = 0;
+  s_sim_s = 0.0;
+  s_wall_ns = 0;
+  mu_sched_set_clock_source(get_time);
+}
+
+mu_time_t mu_sim_now(void) {
+  return s_now;
+}
+
+mu_sim_event_t *mu_sim_inject_isr(mu_sim_event_t *event,
+                                  mu_time_t at,
+                                  mu_task_t *task) {
+  mu_sim_event_t **prev = &s_events;
+
+  event->at = at;
+  event->task = task;
+  // insert after any events at the same time to keep injection order
+  while ((*prev != NULL) && !mu_time_follows((*prev)->at, at)) {
+    prev = &(*prev)->next;
+  }
+  event->next = *prev;
+  *prev = event;
+  return event;
+}
+
+void mu_sim_run_until(mu_time_t until) {
+  mu_time_t start = s_now;
+  uint64_t wall_start = wall_now_ns();
+  mu_time_t deadline;
+
+  while (true) {
+    if (fire_next_event()) {
+      // let the scheduler pick up the task posted from "interrupt level"
+      mu_sched_step();
+      s_step_count += 1;
+
+    } else if (next_deadline(&deadline) && !mu_time_follows(deadline, s_now)) {
+      // something is due now
+      mu_sched_step();
+      s_step_count += 1;
+
+    } else if (next_deadline(&deadline) && !mu_time_follows(deadline, until)) {
+      // nothing is due: jump ahead to the next thing that is
+      s_now = deadline;
+      s_jump_count += 1;
+
+    } else {
+      // nothing more to do before `until`
+      break;
+    }
+  }
+  if (mu_time_precedes(s_now, until)) {
+    s_now = until;
+  }
+
+  s_sim_s += mu_time_duration_to_s(mu_time_difference(s_now, start));
+  s_wall_ns += wall_now_ns() - wall_start;
+}
+
+void mu_sim_run_for(mu_duration_t dt) {
+  mu_sim_run_until(mu_time_offset(s_now, dt));
+}
+
+unsigned long mu_sim_step_count(void) {
+  return s_step_count;
+}
+
+unsigned long mu_sim_jump_count(void) {
+  return s_jump_count;
+}
+
+double mu_sim_speed(void) {
+  if (s_wall_ns == 0) {
+    return 0.0;
+  }
+  return s_sim_s / (s_wall_ns / 1e9);
+}
+
+void mu_sim_report(void) {
+  printf("mu_sim: %.3f s simulated in %.6f s wall (%.0fx), "
+         "%lu steps, %lu jumps\r\n",
+         s_sim_s,
+         s_wall_ns / 1e9,
+         mu_sim_speed(),
+         s_step_count,
+         s_jump_count);
+}
+
+// =============================================================================
+// private code
+
+static mu_time_t get_time(void) {
+  return s_now;
+}
+
+// If the earliest injected event is due, post its task and return true.
+static bool fire_next_event(void) {
+  mu_sim_event_t *event = s_events;
+
+  if ((event == NULL) || mu_time_follows(event->at, s_now)) {
+    return false;
+  }
+  s_events = event->next;
+  event->next = NULL;
+  mu_sched_isr_task_now(event->task);
+  return true;
+}
+
+// Find the earlier of the next scheduled task and the next injected event.
+// Return false if there are neither.
+static bool next_deadline(mu_time_t *deadline) {
+  mu_task_t *task = mu_sched_get_next_task();
+  bool found = false;
+
+  if (task != NULL) {
+    *deadline = mu_task_get_time(task);
+    found = true;
+  }
+  if ((s_events != NULL) &&
+      (!found || mu_time_precedes(s_events->at, *deadline))) {
+    *deadline = s_events->at;
+    found = true;
+  }
+  return found;
+}
+
+static uint64_t wall_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
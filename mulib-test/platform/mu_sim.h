@@ -0,0 +1,141 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _MU_SIM_H_
+#define _MU_SIM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// includes
+
+#include "mu_config.h"
+#include "core/mu_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// =============================================================================
+// types and definitions
+
+/**
+ * @brief An interrupt event to be injected at a chosen virtual time.
+ *
+ * The caller owns the storage.  An event must not be re-injected until it has
+ * fired (or mu_sim_init() has been called).
+ */
+typedef struct _mu_sim_event {
+  struct _mu_sim_event *next;
+  mu_time_t at;
+  mu_task_t *task;
+} mu_sim_event_t;
+
+// =============================================================================
+// declarations
+
+/**
+ * @brief Put the scheduler into virtual time.
+ *
+ * Installs the simulator's clock as the scheduler's clock source, sets virtual
+ * time to `start`, and discards any pending events and statistics.  Call this
+ * after mu_sched_init().
+ *
+ * Code under simulation must read the time via mu_sched_get_current_time() (or
+ * mu_task_get_time()) rather than mu_time_now(), which still reads the host's
+ * clock.  Don't install an idle task that sleeps: the simulator never waits.
+ *
+ * @param start The initial virtual time.
+ */
+void mu_sim_init(mu_time_t start);
+
+/**
+ * @brief Return the current virtual time.
+ */
+mu_time_t mu_sim_now(void);
+
+/**
+ * @brief Arrange for `task` to be posted via mu_sched_isr_task_now() at
+ * virtual time `at`.
+ *
+ * Events fire in time order.  Events injected for the same time fire in the
+ * order they were injected.  Events in the past fire immediately.
+ *
+ * @param event Caller-supplied storage for the event.
+ * @param at The virtual time at which to post the task.
+ * @param task The task to post.
+ * @return event
+ */
+mu_sim_event_t *mu_sim_inject_isr(mu_sim_event_t *event,
+                                  mu_time_t at,
+                                  mu_task_t *task);
+
+/**
+ * @brief Run the scheduler until virtual time `until`.
+ *
+ * Every task and event that is due is run.  When nothing is due, virtual
+ * time jumps straight to the next scheduled task or injected event.  No wall
+ * time is spent waiting.  Returns with virtual time equal to `until`.
+ *
+ * @param until The virtual time at which to stop.
+ */
+void mu_sim_run_until(mu_time_t until);
+
+/**
+ * @brief Run the scheduler for `dt` of virtual time.
+ *
+ * Equivalent to mu_sim_run_until(mu_time_offset(mu_sim_now(), dt)).
+ */
+void mu_sim_run_for(mu_duration_t dt);
+
+/**
+ * @brief Return the number of times mu_sched_step() has been called since
+ * mu_sim_init().
+ */
+unsigned long mu_sim_step_count(void);
+
+/**
+ * @brief Return the number of times virtual time has jumped ahead since
+ * mu_sim_init(), i.e. the number of wakeups real hardware would have taken.
+ */
+unsigned long mu_sim_jump_count(void);
+
+/**
+ * @brief Return the ratio of virtual time to wall time spent in
+ * mu_sim_run_until() since mu_sim_init().
+ *
+ * A value of 3600 means an hour of firmware behavior ran in one second.
+ */
+double mu_sim_speed(void);
+
+/**
+ * @brief Print virtual time, wall time, speed and step counts to stdout.
+ */
+void mu_sim_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #ifndef _MU_SIM_H_
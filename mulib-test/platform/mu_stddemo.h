@@ -0,0 +1,66 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * mu_stddemo.h for the host.
+ *
+ * The host has no LED or button, so this declares only what the demo code
+ * under test calls.  A test that runs demo code defines mu_stddemo_led_set()
+ * itself, to record what the demo does with the LED and when.
+ */
+
+#ifndef _MU_STDDEMO_H_
+#define _MU_STDDEMO_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// includes
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// =============================================================================
+// types and definitions
+
+// =============================================================================
+// declarations
+
+/**
+ * @brief Print a formatted message to standard output.
+ */
+#define mu_stddemo_printf(fmt, ...) printf(fmt, ##__VA_ARGS__)
+
+/**
+ * @brief Set the demo LED on or off.  Defined by the test.
+ */
+void mu_stddemo_led_set(bool on);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _MU_STDDEMO_H_
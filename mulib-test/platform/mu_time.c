@@ -1,12 +1,15 @@
 /**
  * A POSIX-compliant implementation for mu_time.c
  *
- * Note that this implementation represents time in seconds in a double.
+ * Time is a 64-bit count of nanoseconds read from CLOCK_MONOTONIC, which on
+ * Linux is served from the vDSO without a system call.  The time arithmetic
+ * and conversions are static inline in mu_time.h, so only reading the clock
+ * and sleeping live here.
  *
  * To compile and run the in-file unit tests, make sure that the mulib directory
  * is available and at the same level as mulib-test.  In a terminal wndow, type:
  *
- *  cc -Wall -g -I.. -I../../../mulib/src/platform -o mu_time mu_time.c && ./mu_time && rm ./mu_time
+ *  cc -Wall -g -pthread -I.. -I../../../mulib/src/platform -o mu_time mu_time.c && ./mu_time && rm ./mu_time
  *
  * R. D. Poor <rdpoor@gmail.com>
  */
@@ -15,12 +18,42 @@
 #include "mu_time.h"       // included from mulib/src/platform/
 #include "time.h"          // posix time functions
 
+#ifdef MU_CAN_SLEEP
+#include <errno.h>
+#include <pthread.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <unistd.h>
+
+// mu_time_wake() interrupts a sleeping thread by sending it this signal.
+#define WAKE_SIGNAL SIGUSR1
+
+static void wake_signal_handler(int signo);
+static void sleep_until_timespec(const struct timespec *until);
+
+static pthread_t s_sleeper;          // the thread that last called sleep
+static sigjmp_buf s_wake_jmp;        // escape hatch from a sleep in progress
+static volatile sig_atomic_t s_is_sleeping;
+static volatile sig_atomic_t s_wake_pending;
+#endif
+
 /**
  * @brief Initialize the time system.  Must be called before any other time
  * functions are called.
  */
 void mu_time_init(void) {
-  // no initialization required
+#ifdef MU_CAN_SLEEP
+  struct sigaction sa;
+
+  sa.sa_handler = wake_signal_handler;
+  sa.sa_flags = SA_RESTART;  // don't disturb system calls in the foreground
+  sigemptyset(&sa.sa_mask);
+  sigaction(WAKE_SIGNAL, &sa, NULL);
+
+  s_sleeper = pthread_self();
+  s_is_sleeping = 0;
+  s_wake_pending = 0;
+#endif
 }
 
 /**
@@ -30,116 +63,70 @@ void mu_time_init(void) {
  */
 mu_time_t mu_time_now() {
   struct timespec now;
-  clock_gettime(CLOCK_REALTIME, &now);
-  return now.tv_sec + now.tv_nsec / 1000000000.0;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (mu_time_t)now.tv_sec * MU_TIME_NS_PER_S + now.tv_nsec;
 }
 
+#ifdef MU_CAN_SLEEP
 /**
- * @brief Add a time and a duration.
- *
- * `mu_time_offset` adds a time and a duration to produce a new time object.
+ * @brief Sleep until the given time or until mu_time_wake() is called.
  *
- * @param t1 a time object
- * @param dt a duration object
- * @return t1 offset by dt
+ * @param until The time at which to wake up.
  */
-mu_time_t mu_time_offset(mu_time_t t1, mu_duration_t dt) {
-  return t1 + dt;
+void mu_time_sleep_until(mu_time_t until) {
+  struct timespec ts = {.tv_sec = until / MU_TIME_NS_PER_S,
+                        .tv_nsec = until % MU_TIME_NS_PER_S};
+  sleep_until_timespec(&ts);
 }
 
 /**
- * @brief Take the difference between two time objects
- *
- * `mu_time_difference` subtracts t2 from t1 to produce a duration object.
- *
- * @param t1 A time object
- * @param t2 A time object
- * @return (t1-t2) as a duration object
+ * @brief Sleep until mu_time_wake() is called.
  */
-mu_duration_t mu_time_difference(mu_time_t t1, mu_time_t t2) {
-  return t1 - t2;
+void mu_time_sleep(void) {
+  sleep_until_timespec(NULL);
 }
 
 /**
- * @brief Return true if t1 is strictly before t2
- *
- * Note that if you want to know if t1 is before or equal to t2, you can use the
- * construct `!mu_time_follows(t2, t1)``
+ * @brief Cut short a sleep in progress, or make the next one return at once.
  *
- * @param t1 A time object
- * @param t2 A time object
- * @return true if t1 is strictly before t2, false otherwise.
+ * May be called from a signal handler or from any thread.
  */
-bool mu_time_precedes(mu_time_t t1, mu_time_t t2) {
-  return t1 < t2;
+void mu_time_wake(void) {
+  if (pthread_equal(pthread_self(), s_sleeper)) {
+    // Called from a signal handler running on the sleeping thread.
+    wake_signal_handler(WAKE_SIGNAL);
+  } else {
+    pthread_kill(s_sleeper, WAKE_SIGNAL);
+  }
 }
 
-/**
- * @brief Return true if t1 is equal to t2
- *
- * @param t1 A time object
- * @param t2 A time object
- * @return true if t1 equals t2, false otherwise.
- */
-bool mu_time_equals(mu_time_t t1, mu_time_t t2) {
-  return t1 == t2;
-}
-
-/**
- * @brief Return true if t1 is strictly after t2
- *
- * Note that if you want to know if t1 is equal to or after t2, you can use the
- * construct `!mu_time_precedes(t2, t1)``
- *
- * @param t1 A time object
- * @param t2 A time object
- * @return true if t1 is strictly after t2, false otherwise.
- */
-bool mu_time_follows(mu_time_t t1, mu_time_t t2) {
-  return t1 > t2;
+// Runs on the sleeping thread.  If it interrupts a sleep -- including the
+// window between checking s_wake_pending and entering clock_nanosleep() --
+// jump straight out of it, so a wakeup can never be lost.
+static void wake_signal_handler(int signo) {
+  (void)signo;
+  s_wake_pending = 1;
+  if (s_is_sleeping) {
+    siglongjmp(s_wake_jmp, 1);
+  }
 }
 
-/**
- * @brief Convert a duration to milliseconds.
- *
- * @param dt A duration object
- * @return The duration in seconds
- */
-mu_duration_ms_t mu_time_duration_to_ms(mu_duration_t dt) {
-  return dt * 1000.0;
+static void sleep_until_timespec(const struct timespec *until) {
+  s_sleeper = pthread_self();
+  if (sigsetjmp(s_wake_jmp, 1) == 0) {
+    s_is_sleeping = 1;
+    while (!s_wake_pending) {
+      if (until == NULL) {
+        pause();
+      } else if (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, until, NULL) !=
+                 EINTR) {
+        break;  // deadline reached
+      }
+    }
+  }
+  s_is_sleeping = 0;
+  s_wake_pending = 0;
 }
-
-/**
- * @brief Convert milliseconds to a duration
- *
- * @param ms The duration in milliseconds
- * @return A duration object
- */
-mu_duration_t mu_time_ms_to_duration(mu_duration_ms_t ms) {
-  return ms / 1000.0;
-}
-
-#ifdef MU_FLOAT
-/**
- * @brief Convert a duration to seconds.
- *
- * @param dt A duration object
- * @return The duration in seconds
- */
-MU_FLOAT mu_time_duration_to_s(mu_duration_t dt) {
-  return dt;
-}
-
-/**
- * @brief Convert seconds to a duration.
- *
- * @param s The duration in seconds
- * @return A duration object
- */
-mu_duration_t mu_time_s_to_duration(MU_FLOAT s) {
-  return s;
-}
-
 #endif
 
 //#define MU_TIME_TEST
@@ -148,6 +135,15 @@ mu_duration_t mu_time_s_to_duration(MU_FLOAT s) {
 #include <stdio.h>
 #include <assert.h>
 
+#ifdef MU_CAN_SLEEP
+static void *waker_fn(void *arg) {
+  (void)arg;
+  usleep(100000);
+  mu_time_wake();
+  return NULL;
+}
+#endif
+
 int main(void) {
   mu_time_t t1, t2;
   mu_duration_t dt;
@@ -181,6 +177,28 @@ int main(void) {
   s = mu_time_duration_to_s(mu_time_difference(t2, t1));
   assert(s == 1.0);
 
+#ifdef MU_CAN_SLEEP
+  pthread_t waker;
+
+  // sleep until a time in the near future
+  t1 = mu_time_now();
+  dt = mu_time_ms_to_duration(100);
+  mu_time_sleep_until(mu_time_offset(t1, dt));
+  assert(!mu_time_precedes(mu_time_now(), mu_time_offset(t1, dt)));
+
+  // a wakeup that arrives before the sleep makes the sleep return at once
+  t1 = mu_time_now();
+  mu_time_wake();
+  dt = mu_time_ms_to_duration(100000);
+  mu_time_sleep_until(mu_time_offset(t1, dt));
+  assert(mu_time_precedes(mu_time_now(), mu_time_offset(t1, dt)));
+
+  // a wakeup from another thread cuts short an indefinite sleep
+  pthread_create(&waker, NULL, waker_fn, NULL);
+  mu_time_sleep();
+  pthread_join(waker, NULL);
+#endif
+
   printf("done.\r\n");
 
   return 0;
@@ -26,7 +26,7 @@
 #define _MU_TIME_H_
 
 #ifdef __cplusplus
-extern "C";
+extern "C" {
 #endif
 
 // =============================================================================
@@ -39,6 +39,13 @@ extern "C";
 // =============================================================================
 // types and definitions
 
+#define MU_TIME_NS_PER_MS 1000000
+#define MU_TIME_NS_PER_S 1000000000
+
+// Convert milliseconds to a duration.  Folds to a constant when ms is a
+// constant, as on the tick-based ports.
+#define MU_TIME_MS_TO_DURATION(ms) ((mu_duration_t)(ms) * MU_TIME_NS_PER_MS)
+
 // =============================================================================
 // declarations
 
@@ -64,7 +71,9 @@ mu_time_t mu_time_now();
  * @param dt a duration object
  * @return t1 offset by dt
  */
-mu_time_t mu_time_offset(mu_time_t t1, mu_duration_t dt);
+static inline mu_time_t mu_time_offset(mu_time_t t1, mu_duration_t dt) {
+  return t1 + dt;
+}
 
 /**
  * @brief Take the difference between two time objects
@@ -75,7 +84,9 @@ mu_time_t mu_time_offset(mu_time_t t1, mu_duration_t dt);
  * @param t2 A time object
  * @return (t1-t2) as a duration object
  */
-mu_duration_t mu_time_difference(mu_time_t t1, mu_time_t t2);
+static inline mu_duration_t mu_time_difference(mu_time_t t1, mu_time_t t2) {
+  return (mu_duration_t)(t1 - t2);
+}
 
 /**
  * @brief Return true if t1 is strictly before t2
@@ -87,7 +98,9 @@ mu_duration_t mu_time_difference(mu_time_t t1, mu_time_t t2);
  * @param t2 A time object
  * @return true if t1 is strictly before t2, false otherwise.
  */
-bool mu_time_precedes(mu_time_t t1, mu_time_t t2);
+static inline bool mu_time_precedes(mu_time_t t1, mu_time_t t2) {
+  return (mu_duration_t)(t1 - t2) < 0;
+}
 
 /**
  * @brief Return true if t1 is equal to t2
@@ -96,7 +109,9 @@ bool mu_time_precedes(mu_time_t t1, mu_time_t t2);
  * @param t2 A time object
  * @return true if t1 equals t2, false otherwise.
  */
-bool mu_time_equals(mu_time_t t1, mu_time_t t2);
+static inline bool mu_time_equals(mu_time_t t1, mu_time_t t2) {
+  return t1 == t2;
+}
 
 /**
  * @brief Return true if t1 is strictly after t2
@@ -108,15 +123,19 @@ bool mu_time_equals(mu_time_t t1, mu_time_t t2);
  * @param t2 A time object
  * @return true if t1 is strictly after t2, false otherwise.
  */
-bool mu_time_follows(mu_time_t t1, mu_time_t t2);
+static inline bool mu_time_follows(mu_time_t t1, mu_time_t t2) {
+  return (mu_duration_t)(t1 - t2) > 0;
+}
 
 /**
- * @brief Convert a duration to milliseconds.
+ * @brief Convert a duration to milliseconds, truncating toward zero.
  *
  * @param dt A duration object
- * @return The duration in seconds
+ * @return The duration in milliseconds
  */
-mu_duration_ms_t mu_time_duration_to_ms(mu_duration_t dt);
+static inline mu_duration_ms_t mu_time_duration_to_ms(mu_duration_t dt) {
+  return (mu_duration_ms_t)(dt / MU_TIME_NS_PER_MS);
+}
 
 /**
  * @brief Convert milliseconds to a duration
@@ -124,7 +143,9 @@ mu_duration_ms_t mu_time_duration_to_ms(mu_duration_t dt);
  * @param ms The duration in milliseconds
  * @return A duration object
  */
-mu_duration_t mu_time_ms_to_duration(mu_duration_ms_t ms);
+static inline mu_duration_t mu_time_ms_to_duration(mu_duration_ms_t ms) {
+  return (mu_duration_t)ms * MU_TIME_NS_PER_MS;
+}
 
 #ifdef MU_FLOAT
 /**
@@ -133,7 +154,9 @@ mu_duration_t mu_time_ms_to_duration(mu_duration_ms_t ms);
  * @param dt A duration object
  * @return The duration in seconds
  */
-MU_FLOAT mu_time_duration_to_s(mu_duration_t dt);
+static inline MU_FLOAT mu_time_duration_to_s(mu_duration_t dt) {
+  return (MU_FLOAT)dt / MU_TIME_NS_PER_S;
+}
 
 /**
  * @brief Convert seconds to a duration.
@@ -141,7 +164,39 @@ MU_FLOAT mu_time_duration_to_s(mu_duration_t dt);
  * @param s The duration in seconds
  * @return A duration object
  */
-mu_duration_t mu_time_s_to_duration(MU_FLOAT s);
+static inline mu_duration_t mu_time_s_to_duration(MU_FLOAT s) {
+  return (mu_duration_t)(s * MU_TIME_NS_PER_S);
+}
+#endif
+
+#ifdef MU_CAN_SLEEP
+/**
+ * @brief Sleep until the given time or until mu_time_wake() is called.
+ *
+ * This is intended to be called from the scheduler's idle task with the time
+ * of the earliest scheduled task, so the processor wakes only when there is
+ * work to do.  Returns immediately if `until` has already arrived or if
+ * mu_time_wake() has been called since the last sleep.
+ *
+ * @param until The time at which to wake up.
+ */
+void mu_time_sleep_until(mu_time_t until);
+
+/**
+ * @brief Sleep until mu_time_wake() is called.
+ *
+ * Use this from the idle task when there are no scheduled tasks at all.
+ */
+void mu_time_sleep(void);
+
+/**
+ * @brief Cut short a sleep in progress, or make the next one return at once.
+ *
+ * Call this after mu_sched_isr_task_now() from interrupt level (on this host
+ * port: a signal handler or another thread) so the foreground wakes up to run
+ * the newly queued task.
+ */
+void mu_time_wake(void);
 #endif
 
 #ifdef __cplusplus
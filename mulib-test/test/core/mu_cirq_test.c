@@ -77,8 +77,8 @@ void mu_cirq_test() {
 
   mu_cirq_t queue;
   uint8_t a1[] = {1, 2, 3, 4};
-  // uint16_t b1[] = {1, 2, 3, 4};
-  // uint32_t c1[] = {1, 2, 3, 4};
+  uint16_t b1[] = {1111, 2222, 3333, 4444};
+  uint32_t c1[] = {111111, 222222, 333333, 444444};
   item_t items1[4] = {{1, 11, 111}, {2, 22, 222}, {3, 33, 333}, {4, 44, 444}};
 
   mu_cirq_t *q = &queue;
@@ -164,6 +164,40 @@ void mu_cirq_test() {
   ASSERT(s_a2[2] == 2);
   ASSERT(s_a2[3] == 3);
 
+  // same, but with uint16_t sized objects: b1 plays the part of a1
+  reset_statics();
+  ASSERT(mu_cirq_init(q, store, 8) == q);
+  ASSERT(mu_cirq_read_n(q, s_b2, 4, sizeof(uint16_t)) == 0);   // queue was empty
+  ASSERT(mu_cirq_write_n(q, b1, 4, sizeof(uint16_t)) == 4);
+  ASSERT(mu_cirq_write_n(q, b1, 4, sizeof(uint16_t)) == 3);
+  ASSERT(mu_cirq_is_full(q) == true);
+  ASSERT(mu_cirq_read_n(q, s_b2, 3, sizeof(uint16_t)) == 3);
+  ASSERT(s_b2[0] == 1111);
+  ASSERT(s_b2[1] == 2222);
+  ASSERT(s_b2[2] == 3333);
+  ASSERT(mu_cirq_write_n(q, b1, 4, sizeof(uint16_t)) == 3);
+  ASSERT(mu_cirq_read_n(q, s_b2, 4, sizeof(uint16_t)) == 4);
+  ASSERT(s_b2[0] == 4444);
+  ASSERT(s_b2[1] == 1111);
+  ASSERT(s_b2[2] == 2222);
+  ASSERT(s_b2[3] == 3333);
+
+  // same, but with uint32_t sized objects: c1 plays the part of a1
+  reset_statics();
+  ASSERT(mu_cirq_init(q, store, 8) == q);
+  ASSERT(mu_cirq_write_n(q, c1, 4, sizeof(uint32_t)) == 4);
+  ASSERT(mu_cirq_write_n(q, c1, 4, sizeof(uint32_t)) == 3);
+  ASSERT(mu_cirq_read_n(q, s_c2, 3, sizeof(uint32_t)) == 3);
+  ASSERT(s_c2[0] == 111111);
+  ASSERT(s_c2[1] == 222222);
+  ASSERT(s_c2[2] == 333333);
+  ASSERT(mu_cirq_write_n(q, c1, 4, sizeof(uint32_t)) == 3);
+  ASSERT(mu_cirq_read_n(q, s_c2, 4, sizeof(uint32_t)) == 4);
+  ASSERT(s_c2[0] == 444444);
+  ASSERT(s_c2[1] == 111111);
+  ASSERT(s_c2[2] == 222222);
+  ASSERT(s_c2[3] == 333333);
+
   // same, but with item_t sized objects...
   reset_statics();
   ASSERT(mu_cirq_init(q, store, 8) == q);
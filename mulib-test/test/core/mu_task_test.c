@@ -69,7 +69,7 @@ void mu_task_test() {
   ASSERT(mu_task_init(&t2, task_fn2, NULL, "Task2") == &t2);
 #if (MU_TASK_PROFILING)
   ASSERT(strcmp(mu_task_name(&t1), "Task1") == 0);
-  ASSERT(strcmp(mu_task_name(&t1), "Task2") == 0);
+  ASSERT(strcmp(mu_task_name(&t2), "Task2") == 0);
 #endif
 
   mu_task_call(&t1, &t1);
@@ -47,11 +47,10 @@ void mu_time_test() {
   mu_time_t t2;
 
   mu_duration_t dt1;
-  mu_duration_ms_t dm1;
 
   t1 = mu_time_now();   // an arbitrary time
-  dm1 = mu_time_ms_to_duration(1000);
-  t2 = mu_time_offset(t1, dm1);
+  dt1 = mu_time_ms_to_duration(1000);
+  t2 = mu_time_offset(t1, dt1);
 
   ASSERT(mu_time_precedes(t1, t2) == true);
   ASSERT(mu_time_precedes(t1, t1) == false);
@@ -72,7 +71,7 @@ void mu_time_test() {
 
   t1 = mu_time_now();   // an arbitrary time
   ds1 = mu_time_s_to_duration(1.0);
-  t2 = mu_time_offset(t1, dm1);
+  t2 = mu_time_offset(t1, ds1);
 
   ASSERT(mu_time_precedes(t1, t2) == true);
   ASSERT(mu_time_precedes(t1, t1) == false);
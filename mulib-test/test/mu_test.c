@@ -36,13 +36,20 @@
 
 int mu_bvec_test();
 int mu_cirq_test();
+int mu_coro_test();
+int mu_cyclic_test();
 int mu_dlist_test();
 int mu_fsm_test();
+int mu_hist_test();
 int mu_list_test();
 int mu_log_test();
+int mu_mpmcq_test();
+int mu_mpscq_test();
 int mu_pstore_test();
 int mu_queue_test();
 int mu_sched_test();
+int mu_signal_test();
+int mu_sim_test();
 // int mu_spscq_test();
 int mu_str_test();
 int mu_strbuf_test();
@@ -62,13 +69,20 @@ int main() {
 
   mu_bvec_test();
   mu_cirq_test();
+  mu_coro_test();
+  mu_cyclic_test();
   mu_dlist_test();
   mu_fsm_test();
+  mu_hist_test();
   mu_list_test();
   mu_log_test();
+  mu_mpmcq_test();
+  mu_mpscq_test();
   mu_pstore_test();
   mu_queue_test();
   mu_sched_test();
+  mu_signal_test();
+  mu_sim_test();
   // mu_spscq_test();
   mu_str_test();
   mu_strbuf_test();
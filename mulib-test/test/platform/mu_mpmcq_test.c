@@ -0,0 +1,226 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_test_utils.h"
+#include "mu_mpmcq.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+
+// =============================================================================
+// private types and definitions
+
+#define POOL_SIZE 4
+
+// Stress test: each producer puts the values 1..STRESS_ITEMS, tagged with its
+// id, through a deliberately small queue so it is often full and empty.
+#define STRESS_PRODUCERS 4
+#define STRESS_CONSUMERS 4
+#define STRESS_ITEMS 20000
+#define STRESS_POOL_SIZE 16
+
+// tag a value with its producer's id, and take it apart again
+#define STRESS_ENCODE(producer, value)                                         \
+  ((mu_mpmcq_item_t)(((uintptr_t)(producer) << 24) | (uintptr_t)(value)))
+#define STRESS_PRODUCER(item) ((int)((uintptr_t)(item) >> 24))
+#define STRESS_VALUE(item) ((int)((uintptr_t)(item) & 0xffffff))
+
+// =============================================================================
+// private declarations
+
+static void stress_test(void);
+
+static void *producer_fn(void *arg);
+
+static void *consumer_fn(void *arg);
+
+// =============================================================================
+// local storage
+
+static mu_mpmcq_slot_t s_slots[POOL_SIZE];
+static int item0 = 0;
+static int item1 = 1;
+static int item2 = 2;
+static int item3 = 3;
+static int item4 = 4;
+
+static mu_mpmcq_t s_stress_q;
+static mu_mpmcq_slot_t s_stress_slots[STRESS_POOL_SIZE];
+
+// how many times each (producer, value) was received: must end up all ones
+static atomic_uchar s_received[STRESS_PRODUCERS][STRESS_ITEMS + 1];
+
+static atomic_long s_consumed;
+
+// set by a consumer that sees a producer's values out of order
+static atomic_int s_out_of_order;
+
+// =============================================================================
+// public code
+
+void mu_mpmcq_test() {
+  mu_mpmcq_t qi;
+  mu_mpmcq_t *q = &qi;
+  mu_mpmcq_item_t item;
+
+  // mu_mpmcq_err_t mu_mpmcq_init(mu_mpmcq_t *q, mu_mpmcq_slot_t *slots, size_t size);
+  // size must be a power of two
+  ASSERT(mu_mpmcq_init(q, s_slots, 0) == MU_MPMCQ_ERR_SIZE);
+  ASSERT(mu_mpmcq_init(q, s_slots, POOL_SIZE - 1) == MU_MPMCQ_ERR_SIZE);
+  ASSERT(mu_mpmcq_init(q, s_slots, POOL_SIZE) == MU_MPMCQ_ERR_NONE);
+  ASSERT(mu_mpmcq_capacity(q) == POOL_SIZE);
+  ASSERT(mu_mpmcq_count(q) == 0);
+
+  // mu_mpmcq_err_t mu_mpmcq_put(mu_mpmcq_t *q, mu_mpmcq_item_t item);
+  // unlike mu_spscq, every slot is usable
+  ASSERT(mu_mpmcq_put(q, &item0) == MU_MPMCQ_ERR_NONE);
+  ASSERT(mu_mpmcq_put(q, &item1) == MU_MPMCQ_ERR_NONE);
+  ASSERT(mu_mpmcq_put(q, &item2) == MU_MPMCQ_ERR_NONE);
+  ASSERT(mu_mpmcq_put(q, &item3) == MU_MPMCQ_ERR_NONE);
+  ASSERT(mu_mpmcq_count(q) == 4);
+  ASSERT(mu_mpmcq_put(q, &item4) == MU_MPMCQ_ERR_FULL);
+  ASSERT(mu_mpmcq_count(q) == 4);
+
+  // mu_mpmcq_err_t mu_mpmcq_get(mu_mpmcq_t *q, mu_mpmcq_item_t *item);
+  ASSERT(mu_mpmcq_get(q, &item) == MU_MPMCQ_ERR_NONE);
+  ASSERT(item == &item0);
+  ASSERT(mu_mpmcq_get(q, &item) == MU_MPMCQ_ERR_NONE);
+  ASSERT(item == &item1);
+  ASSERT(mu_mpmcq_count(q) == 2);
+
+  // wrap into the second lap
+  ASSERT(mu_mpmcq_put(q, &item4) == MU_MPMCQ_ERR_NONE);
+  ASSERT(mu_mpmcq_put(q, &item0) == MU_MPMCQ_ERR_NONE);
+  ASSERT(mu_mpmcq_put(q, &item1) == MU_MPMCQ_ERR_FULL);
+  ASSERT(mu_mpmcq_get(q, &item) == MU_MPMCQ_ERR_NONE);
+  ASSERT(item == &item2);
+  ASSERT(mu_mpmcq_get(q, &item) == MU_MPMCQ_ERR_NONE);
+  ASSERT(item == &item3);
+  ASSERT(mu_mpmcq_get(q, &item) == MU_MPMCQ_ERR_NONE);
+  ASSERT(item == &item4);
+  ASSERT(mu_mpmcq_get(q, &item) == MU_MPMCQ_ERR_NONE);
+  ASSERT(item == &item0);
+  ASSERT(mu_mpmcq_count(q) == 0);
+
+  // get from an empty queue fails
+  ASSERT(mu_mpmcq_get(q, &item) == MU_MPMCQ_ERR_EMPTY);
+  ASSERT(item == NULL);
+
+  // many laps: the sequence numbers keep up
+  for (int i = 0; i < 100; i++) {
+    ASSERT(mu_mpmcq_put(q, &item1) == MU_MPMCQ_ERR_NONE);
+    ASSERT(mu_mpmcq_put(q, &item2) == MU_MPMCQ_ERR_NONE);
+    ASSERT(mu_mpmcq_put(q, &item3) == MU_MPMCQ_ERR_NONE);
+    ASSERT(mu_mpmcq_get(q, &item) == MU_MPMCQ_ERR_NONE && item == &item1);
+    ASSERT(mu_mpmcq_get(q, &item) == MU_MPMCQ_ERR_NONE && item == &item2);
+    ASSERT(mu_mpmcq_get(q, &item) == MU_MPMCQ_ERR_NONE && item == &item3);
+  }
+  ASSERT(mu_mpmcq_count(q) == 0);
+
+  stress_test();
+}
+
+// =============================================================================
+// private code
+
+/**
+ * Producers and consumers hammer a small queue at once.  Afterwards every
+ * value must have been received exactly once, and each consumer must have
+ * seen each producer's values in increasing order: a FIFO queue can't hand
+ * a later put to a consumer before an earlier one it already handed over.
+ */
+static void stress_test(void) {
+  pthread_t producers[STRESS_PRODUCERS];
+  pthread_t consumers[STRESS_CONSUMERS];
+  int missing_or_duplicated = 0;
+
+  ASSERT(mu_mpmcq_init(&s_stress_q, s_stress_slots, STRESS_POOL_SIZE) ==
+         MU_MPMCQ_ERR_NONE);
+  memset(s_received, 0, sizeof(s_received));
+  atomic_store(&s_consumed, 0);
+  atomic_store(&s_out_of_order, 0);
+
+  for (intptr_t i = 0; i < STRESS_CONSUMERS; i++) {
+    ASSERT(pthread_create(&consumers[i], NULL, consumer_fn, NULL) == 0);
+  }
+  for (intptr_t i = 0; i < STRESS_PRODUCERS; i++) {
+    ASSERT(pthread_create(&producers[i], NULL, producer_fn, (void *)i) == 0);
+  }
+  for (int i = 0; i < STRESS_PRODUCERS; i++) {
+    pthread_join(producers[i], NULL);
+  }
+  for (int i = 0; i < STRESS_CONSUMERS; i++) {
+    pthread_join(consumers[i], NULL);
+  }
+
+  ASSERT(atomic_load(&s_consumed) == (long)STRESS_PRODUCERS * STRESS_ITEMS);
+  ASSERT(atomic_load(&s_out_of_order) == 0);
+  for (int p = 0; p < STRESS_PRODUCERS; p++) {
+    for (int v = 1; v <= STRESS_ITEMS; v++) {
+      if (atomic_load(&s_received[p][v]) != 1) {
+        missing_or_duplicated += 1;
+      }
+    }
+  }
+  ASSERT(missing_or_duplicated == 0);
+  ASSERT(mu_mpmcq_count(&s_stress_q) == 0);
+}
+
+static void *producer_fn(void *arg) {
+  int producer = (int)(intptr_t)arg;
+
+  for (int v = 1; v <= STRESS_ITEMS; v++) {
+    while (mu_mpmcq_put(&s_stress_q, STRESS_ENCODE(producer, v)) !=
+           MU_MPMCQ_ERR_NONE) {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static void *consumer_fn(void *arg) {
+  int last[STRESS_PRODUCERS] = {0};
+  mu_mpmcq_item_t item;
+  (void)arg;
+
+  while (atomic_load(&s_consumed) < (long)STRESS_PRODUCERS * STRESS_ITEMS) {
+    if (mu_mpmcq_get(&s_stress_q, &item) != MU_MPMCQ_ERR_NONE) {
+      sched_yield();
+      continue;
+    }
+    int p = STRESS_PRODUCER(item);
+    int v = STRESS_VALUE(item);
+    if (v <= last[p]) {
+      atomic_store(&s_out_of_order, 1);
+    }
+    last[p] = v;
+    atomic_fetch_add(&s_received[p][v], 1);
+    atomic_fetch_add(&s_consumed, 1);
+  }
+  return NULL;
+}
@@ -0,0 +1,262 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_test_utils.h"
+#include "mu_mpscq.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+
+// =============================================================================
+// private types and definitions
+
+#define POOL_SIZE 4
+
+// Stress test: each producer posts the values 1..STRESS_ITEMS, tagged with
+// its id, through a deliberately small queue.  Like an ISR, a producer
+// doesn't wait when the queue is full: the post is dropped and counted.
+#define STRESS_PRODUCERS 4
+#define STRESS_ITEMS 20000
+#define STRESS_POOL_SIZE 16
+
+// tag a value with its producer's id, and take it apart again
+#define STRESS_ENCODE(producer, value)                                         \
+  ((mu_mpscq_item_t)(((uintptr_t)(producer) << 24) | (uintptr_t)(value)))
+#define STRESS_PRODUCER(item) ((int)((uintptr_t)(item) >> 24))
+#define STRESS_VALUE(item) ((int)((uintptr_t)(item) & 0xffffff))
+
+// =============================================================================
+// private declarations
+
+static void stress_test(void);
+
+static void *producer_fn(void *arg);
+
+// =============================================================================
+// local storage
+
+static mu_mpscq_slot_t s_slots[POOL_SIZE];
+static int item0 = 0;
+static int item1 = 1;
+static int item2 = 2;
+static int item3 = 3;
+static int item4 = 4;
+
+static mu_mpscq_t s_stress_q;
+static mu_mpscq_slot_t s_stress_slots[STRESS_POOL_SIZE];
+
+// Each (producer, value) is either received or dropped, and never both.  The
+// consumer writes s_received; each producer writes its own row of s_dropped.
+static unsigned char s_received[STRESS_PRODUCERS][STRESS_ITEMS + 1];
+static unsigned char s_dropped[STRESS_PRODUCERS][STRESS_ITEMS + 1];
+
+static atomic_int s_producers_done;
+
+// =============================================================================
+// public code
+
+void mu_mpscq_test() {
+  mu_mpscq_t qi;
+  mu_mpscq_t *q = &qi;
+  mu_mpscq_item_t item;
+
+  // mu_mpscq_err_t mu_mpscq_init(mu_mpscq_t *q, mu_mpscq_slot_t *slots, size_t size);
+  // size must be a power of two
+  ASSERT(mu_mpscq_init(q, s_slots, 0) == MU_MPSCQ_ERR_SIZE);
+  ASSERT(mu_mpscq_init(q, s_slots, POOL_SIZE - 1) == MU_MPSCQ_ERR_SIZE);
+  ASSERT(mu_mpscq_init(q, s_slots, POOL_SIZE) == MU_MPSCQ_ERR_NONE);
+  ASSERT(mu_mpscq_capacity(q) == POOL_SIZE);
+  ASSERT(mu_mpscq_count(q) == 0);
+  ASSERT(mu_mpscq_overflow_count(q) == 0);
+  ASSERT(mu_mpscq_high_water(q) == 0);
+
+  // mu_mpscq_err_t mu_mpscq_put(mu_mpscq_t *q, mu_mpscq_item_t item);
+  // every slot is usable, and a put into a full queue is counted
+  ASSERT(mu_mpscq_put(q, &item0) == MU_MPSCQ_ERR_NONE);
+  ASSERT(mu_mpscq_put(q, &item1) == MU_MPSCQ_ERR_NONE);
+  ASSERT(mu_mpscq_put(q, &item2) == MU_MPSCQ_ERR_NONE);
+  ASSERT(mu_mpscq_put(q, &item3) == MU_MPSCQ_ERR_NONE);
+  ASSERT(mu_mpscq_count(q) == 4);
+  ASSERT(mu_mpscq_overflow_count(q) == 0);
+  ASSERT(mu_mpscq_put(q, &item4) == MU_MPSCQ_ERR_FULL);
+  ASSERT(mu_mpscq_put(q, &item4) == MU_MPSCQ_ERR_FULL);
+  ASSERT(mu_mpscq_count(q) == 4);
+  ASSERT(mu_mpscq_overflow_count(q) == 2);
+
+  // mu_mpscq_err_t mu_mpscq_get(mu_mpscq_t *q, mu_mpscq_item_t *item);
+  // size_t mu_mpscq_high_water(mu_mpscq_t *q);
+  // the first get finds the queue full
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE);
+  ASSERT(item == &item0);
+  ASSERT(mu_mpscq_high_water(q) == 4);
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE);
+  ASSERT(item == &item1);
+  ASSERT(mu_mpscq_count(q) == 2);
+
+  // wrap into the second lap
+  ASSERT(mu_mpscq_put(q, &item4) == MU_MPSCQ_ERR_NONE);
+  ASSERT(mu_mpscq_put(q, &item0) == MU_MPSCQ_ERR_NONE);
+  ASSERT(mu_mpscq_put(q, &item1) == MU_MPSCQ_ERR_FULL);
+  ASSERT(mu_mpscq_overflow_count(q) == 3);
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE);
+  ASSERT(item == &item2);
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE);
+  ASSERT(item == &item3);
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE);
+  ASSERT(item == &item4);
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE);
+  ASSERT(item == &item0);
+  ASSERT(mu_mpscq_count(q) == 0);
+
+  // get from an empty queue fails
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_EMPTY);
+  ASSERT(item == NULL);
+
+  // void mu_mpscq_reset_stats(mu_mpscq_t *q);
+  mu_mpscq_reset_stats(q);
+  ASSERT(mu_mpscq_overflow_count(q) == 0);
+  ASSERT(mu_mpscq_high_water(q) == 0);
+
+  // many laps: the sequence numbers keep up, and the high water mark is the
+  // deepest the consumer found the queue
+  for (int i = 0; i < 100; i++) {
+    ASSERT(mu_mpscq_put(q, &item1) == MU_MPSCQ_ERR_NONE);
+    ASSERT(mu_mpscq_put(q, &item2) == MU_MPSCQ_ERR_NONE);
+    ASSERT(mu_mpscq_put(q, &item3) == MU_MPSCQ_ERR_NONE);
+    ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE && item == &item1);
+    ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE && item == &item2);
+    ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE && item == &item3);
+  }
+  ASSERT(mu_mpscq_count(q) == 0);
+  ASSERT(mu_mpscq_high_water(q) == 3);
+  ASSERT(mu_mpscq_overflow_count(q) == 0);
+
+  // A producer preempted between claiming a slot and publishing it stalls
+  // the consumer there.  Nothing behind it is lost or reordered.  Claim a
+  // slot by hand, as such a producer would, then let another producer post.
+  size_t pos = atomic_fetch_add(&q->put_index, 1);
+  ASSERT(mu_mpscq_put(q, &item2) == MU_MPSCQ_ERR_NONE);
+  ASSERT(mu_mpscq_count(q) == 2);
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_EMPTY);
+  q->slots[pos & q->mask].item = &item1;
+  atomic_store(&q->slots[pos & q->mask].seq, pos + 1);
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE && item == &item1);
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_NONE && item == &item2);
+  ASSERT(mu_mpscq_get(q, &item) == MU_MPSCQ_ERR_EMPTY);
+
+  stress_test();
+}
+
+// =============================================================================
+// private code
+
+/**
+ * Producer threads post into a small queue while this thread consumes.
+ * Afterwards every value must have been either received once or dropped,
+ * the drops must match the overflow count, each producer's values must have
+ * arrived in the order posted, and the high water mark must not exceed the
+ * capacity.
+ */
+static void stress_test(void) {
+  pthread_t producers[STRESS_PRODUCERS];
+  int last[STRESS_PRODUCERS] = {0};
+  int out_of_order = 0;
+  int unaccounted = 0;
+  unsigned long received = 0;
+  unsigned long dropped = 0;
+  mu_mpscq_item_t item;
+
+  ASSERT(mu_mpscq_init(&s_stress_q, s_stress_slots, STRESS_POOL_SIZE) ==
+         MU_MPSCQ_ERR_NONE);
+  memset(s_received, 0, sizeof(s_received));
+  memset(s_dropped, 0, sizeof(s_dropped));
+  atomic_store(&s_producers_done, 0);
+
+  for (intptr_t i = 0; i < STRESS_PRODUCERS; i++) {
+    ASSERT(pthread_create(&producers[i], NULL, producer_fn, (void *)i) == 0);
+  }
+
+  // Consume until every producer has finished and the queue is drained.
+  // Read the done count before the get: a producer that finished before
+  // that read has published everything it will publish.
+  for (;;) {
+    int done = atomic_load(&s_producers_done);
+    if (mu_mpscq_get(&s_stress_q, &item) != MU_MPSCQ_ERR_NONE) {
+      if (done == STRESS_PRODUCERS) {
+        break;
+      }
+      sched_yield();
+      continue;
+    }
+    int p = STRESS_PRODUCER(item);
+    int v = STRESS_VALUE(item);
+    if (v <= last[p]) {
+      out_of_order += 1;
+    }
+    last[p] = v;
+    s_received[p][v] += 1;
+    received += 1;
+  }
+
+  for (int i = 0; i < STRESS_PRODUCERS; i++) {
+    pthread_join(producers[i], NULL);
+  }
+
+  ASSERT(out_of_order == 0);
+  for (int p = 0; p < STRESS_PRODUCERS; p++) {
+    for (int v = 1; v <= STRESS_ITEMS; v++) {
+      if (s_received[p][v] + s_dropped[p][v] != 1) {
+        unaccounted += 1;
+      }
+      dropped += s_dropped[p][v];
+    }
+  }
+  ASSERT(unaccounted == 0);
+  ASSERT(received + dropped == (unsigned long)STRESS_PRODUCERS * STRESS_ITEMS);
+  ASSERT(mu_mpscq_overflow_count(&s_stress_q) == dropped);
+  ASSERT(mu_mpscq_high_water(&s_stress_q) >= 1);
+  ASSERT(mu_mpscq_high_water(&s_stress_q) <= STRESS_POOL_SIZE);
+  ASSERT(mu_mpscq_count(&s_stress_q) == 0);
+}
+
+static void *producer_fn(void *arg) {
+  int producer = (int)(intptr_t)arg;
+
+  for (int v = 1; v <= STRESS_ITEMS; v++) {
+    if (mu_mpscq_put(&s_stress_q, STRESS_ENCODE(producer, v)) !=
+        MU_MPSCQ_ERR_NONE) {
+      s_dropped[producer][v] = 1;
+    }
+    // give the consumer a chance now and then, so not every post overflows
+    if ((v & 0x3f) == 0) {
+      sched_yield();
+    }
+  }
+  atomic_fetch_add(&s_producers_done, 1);
+  return NULL;
+}
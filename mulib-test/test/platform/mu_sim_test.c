@@ -0,0 +1,179 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_test_utils.h"
+#include "mu_sim.h"
+#include "core/mu_sched.h"
+#include "core/mu_timer.h"
+
+// =============================================================================
+// private types and definitions
+
+#define MAX_CALLS 10
+
+// a ten second timer, run for an hour
+#define PERIOD_MS 10000
+#define HOUR_MS 3600000
+
+// =============================================================================
+// private declarations
+
+static void setup(void);
+
+static void tick_fn(void *ctx, void *arg);
+
+static void record_fn(void *ctx, void *arg);
+
+// =============================================================================
+// local storage
+
+static mu_task_t s_tick_task;
+static int s_tick_count;
+
+static mu_timer_t s_timer;
+
+static mu_task_t s_task_a;
+static mu_task_t s_task_b;
+static mu_sim_event_t s_event_1;
+static mu_sim_event_t s_event_2;
+static mu_sim_event_t s_event_3;
+
+// which task ran, and at what (virtual) time
+static mu_task_t *s_called_tasks[MAX_CALLS];
+static mu_time_t s_called_times[MAX_CALLS];
+static int s_call_count;
+
+// =============================================================================
+// public code
+
+void mu_sim_test() {
+
+  // virtual time starts where it's told to and doesn't move on its own
+  setup();
+  ASSERT(mu_sim_now() == 100);
+  ASSERT(mu_sched_get_current_time() == 100);
+  ASSERT(mu_sim_step_count() == 0);
+  ASSERT(mu_sim_jump_count() == 0);
+
+  // with nothing to do, time jumps straight to the end
+  mu_sim_run_until(200);
+  ASSERT(mu_sim_now() == 200);
+  ASSERT(mu_sim_step_count() == 0);
+  ASSERT(mu_sim_jump_count() == 0);
+
+  // a periodic timer runs once per period, with one jump per wakeup
+  setup();
+  mu_task_init(&s_tick_task, tick_fn, NULL, "Tick Task");
+  mu_timer_periodic(&s_timer, &s_tick_task);
+  mu_timer_start(&s_timer, mu_time_ms_to_duration(PERIOD_MS));
+  mu_sim_run_for(mu_time_ms_to_duration(HOUR_MS));
+  ASSERT(mu_sim_now() == mu_time_offset(100, mu_time_ms_to_duration(HOUR_MS)));
+  ASSERT(s_tick_count == 360);
+  ASSERT(mu_sim_jump_count() == 360);
+  ASSERT(mu_sim_step_count() == 360);
+  mu_timer_stop(&s_timer);
+
+  // running in two pieces gives the same answer as running in one
+  setup();
+  mu_timer_periodic(&s_timer, &s_tick_task);
+  mu_timer_start(&s_timer, mu_time_ms_to_duration(PERIOD_MS));
+  mu_sim_run_until(mu_time_offset(100, mu_time_ms_to_duration(HOUR_MS / 2 + 5)));
+  ASSERT(s_tick_count == 180);
+  ASSERT(mu_sim_now() ==
+         mu_time_offset(100, mu_time_ms_to_duration(HOUR_MS / 2 + 5)));
+  mu_sim_run_until(mu_time_offset(100, mu_time_ms_to_duration(HOUR_MS)));
+  ASSERT(s_tick_count == 360);
+  mu_timer_stop(&s_timer);
+
+  // injected events fire at their virtual time, in time order, and events at
+  // the same time fire in injection order
+  setup();
+  mu_task_init(&s_task_a, record_fn, NULL, "Task A");
+  mu_task_init(&s_task_b, record_fn, NULL, "Task B");
+  mu_sim_inject_isr(&s_event_1, 150, &s_task_a);
+  mu_sim_inject_isr(&s_event_2, 120, &s_task_b);
+  mu_sim_inject_isr(&s_event_3, 150, &s_task_b);
+  mu_sim_run_until(140);
+  ASSERT(s_call_count == 1);
+  ASSERT(s_called_tasks[0] == &s_task_b);
+  ASSERT(s_called_times[0] == 120);
+  mu_sim_run_until(200);
+  ASSERT(s_call_count == 3);
+  ASSERT(s_called_tasks[1] == &s_task_a);
+  ASSERT(s_called_times[1] == 150);
+  ASSERT(s_called_tasks[2] == &s_task_b);
+  ASSERT(s_called_times[2] == 150);
+  ASSERT(mu_sim_now() == 200);
+
+  // injected events interleave with scheduled tasks
+  setup();
+  mu_task_init(&s_task_a, record_fn, NULL, "Task A");
+  mu_task_init(&s_task_b, record_fn, NULL, "Task B");
+  mu_sched_task_at(&s_task_a, 130);
+  mu_sim_inject_isr(&s_event_1, 110, &s_task_b);
+  mu_sim_run_for(100);
+  ASSERT(s_call_count == 2);
+  ASSERT(s_called_tasks[0] == &s_task_b);
+  ASSERT(s_called_times[0] == 110);
+  ASSERT(s_called_tasks[1] == &s_task_a);
+  ASSERT(s_called_times[1] == 130);
+
+  // events in the past fire at once
+  setup();
+  mu_sim_inject_isr(&s_event_1, 50, &s_task_a);
+  mu_sim_run_for(0);
+  ASSERT(s_call_count == 1);
+  ASSERT(s_called_times[0] == 100);
+
+  mu_sched_reset();
+}
+
+// =============================================================================
+// private code
+
+static void setup(void) {
+  mu_sched_init();
+  mu_sim_init(100);
+  s_tick_count = 0;
+  s_call_count = 0;
+}
+
+static void tick_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+  s_tick_count += 1;
+}
+
+static void record_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+  if (s_call_count < MAX_CALLS) {
+    s_called_tasks[s_call_count] = mu_sched_get_current_task();
+    s_called_times[s_call_count] = mu_sched_get_current_time();
+    s_call_count += 1;
+  }
+}
@@ -0,0 +1,270 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_test_utils.h"
+#include "mu_sim.h"
+#include "morse_3/mu_coro.h"
+#include "morse_3/morse_char.h"
+#include "morse_3/morse_str.h"
+#include "core/mu_sched.h"
+
+// =============================================================================
+// private types and definitions
+
+#define START 1000
+
+#define MAX_POINTS 20
+#define MAX_EDGES 40
+
+// resume points reached by coro_fn, plus the tasks that run in between
+typedef enum {
+  POINT_BEGIN,
+  POINT_YIELD,
+  POINT_AWAIT_FOR,
+  POINT_AWAIT_UNTIL,
+  POINT_AWAIT,
+  POINT_OTHER,
+  POINT_SUB,
+} point_t;
+
+#define AWAIT_FOR_DT 10
+#define AWAIT_UNTIL_AT (START + 100)
+#define SUB_DELAY 7
+
+// morse_char's time unit
+#define QUANTUM MU_TIME_MS_TO_DURATION(100)
+
+typedef struct {
+  mu_task_t task;
+  mu_coro_t coro;
+} coro_ctx_t;
+
+// =============================================================================
+// private declarations
+
+static void setup(void);
+
+static void coro_fn(void *ctx, void *arg);
+
+static void other_fn(void *ctx, void *arg);
+
+static void sub_fn(void *ctx, void *arg);
+
+static void done_fn(void *ctx, void *arg);
+
+static void record(point_t point);
+
+static bool edges_match(const int *quanta, int n_quanta);
+
+// =============================================================================
+// local storage
+
+static coro_ctx_t s_coro;
+static mu_task_t s_other_task;
+static mu_task_t s_sub_task;
+static mu_task_t s_done_task;
+
+// the points reached, in order, and the (virtual) time of each
+static point_t s_points[MAX_POINTS];
+static mu_time_t s_point_times[MAX_POINTS];
+static int s_point_count;
+
+// the times at which the LED changed state, starting with off -> on
+static mu_time_t s_edges[MAX_EDGES];
+static int s_edge_count;
+static bool s_led;
+
+static mu_time_t s_done_at;
+static int s_done_count;
+
+// The LED edges for "A" (". -") and "SOS", in quanta from the start of the
+// first character.  A dot is on for one quantum and a dash for three, with
+// one quantum off between them and five between characters.  These are the
+// timings of the hand-written state machines morse_3 used before mu_coro.
+static const int s_a_edges[] = {0, 1, 2, 5};
+static const int s_sos_edges[] = {0,  1,  2,  3,  4,  5,  10, 13, 14,
+                                  17, 18, 21, 26, 27, 28, 29, 30, 31};
+
+// =============================================================================
+// public code
+
+void mu_coro_test() {
+  // Each suspend macro returns to the scheduler and resumes just after
+  // itself.  POINT_BEGIN is recorded once, so no resume re-runs the code
+  // before its suspend point.
+  setup();
+  mu_sched_task_now(&s_coro.task);
+  mu_sched_task_now(&s_other_task);
+  mu_sim_run_for(AWAIT_UNTIL_AT + SUB_DELAY + 1 - START);
+  ASSERT(s_point_count == 7);
+
+  // MU_YIELD lets the other task that is due now run before resuming, with
+  // no time passing
+  ASSERT(s_points[0] == POINT_BEGIN);
+  ASSERT(s_point_times[0] == START);
+  ASSERT(s_points[1] == POINT_OTHER);
+  ASSERT(s_point_times[1] == START);
+  ASSERT(s_points[2] == POINT_YIELD);
+  ASSERT(s_point_times[2] == START);
+
+  // MU_AWAIT_FOR resumes after the given duration
+  ASSERT(s_points[3] == POINT_AWAIT_FOR);
+  ASSERT(s_point_times[3] == START + AWAIT_FOR_DT);
+
+  // MU_AWAIT_UNTIL resumes at the given time
+  ASSERT(s_points[4] == POINT_AWAIT_UNTIL);
+  ASSERT(s_point_times[4] == AWAIT_UNTIL_AT);
+
+  // MU_AWAIT starts the sub-task at once, and resumes when the sub-task
+  // schedules the coroutine's task
+  ASSERT(s_points[5] == POINT_SUB);
+  ASSERT(s_point_times[5] == AWAIT_UNTIL_AT);
+  ASSERT(s_points[6] == POINT_AWAIT);
+  ASSERT(s_point_times[6] == AWAIT_UNTIL_AT + SUB_DELAY);
+
+  // MU_CORO_END resets the resume point and leaves the task unscheduled, so
+  // the next call starts over
+  ASSERT(s_coro.coro == 0);
+  ASSERT(mu_sched_is_empty() == true);
+  mu_time_t restart_at = mu_sim_now();
+  mu_sched_task_now(&s_coro.task);
+  mu_sim_run_for(1);
+  ASSERT(s_point_count == 9);
+  ASSERT(s_points[7] == POINT_BEGIN);
+  ASSERT(s_points[8] == POINT_YIELD);
+  ASSERT(s_point_times[8] == restart_at);
+
+  // morse_char: blink one character, then call on_completion after the
+  // inter-character gap
+  setup();
+  mu_sched_task_now(morse_char_init('A', &s_done_task));
+  mu_sim_run_for(60 * QUANTUM);
+  ASSERT(edges_match(s_a_edges, sizeof(s_a_edges) / sizeof(int)));
+  ASSERT(s_led == false);
+  ASSERT(s_done_count == 1);
+  ASSERT(s_done_at == START + 10 * QUANTUM);
+  ASSERT(mu_sched_is_empty() == true);
+
+  // morse_str awaits each morse_char in turn, then calls on_completion a
+  // second after the last one completes
+  setup();
+  mu_sched_task_now(morse_str_init("SOS", &s_done_task));
+  mu_sim_run_for(60 * QUANTUM);
+  ASSERT(edges_match(s_sos_edges, sizeof(s_sos_edges) / sizeof(int)));
+  ASSERT(s_led == false);
+  ASSERT(s_done_count == 1);
+  ASSERT(s_done_at == START + 36 * QUANTUM + MU_TIME_MS_TO_DURATION(1000));
+  ASSERT(mu_sched_is_empty() == true);
+
+  mu_sched_reset();
+}
+
+// The host's mu_stddemo.h leaves this to the test: record each change of the
+// LED's state and when it happened.
+void mu_stddemo_led_set(bool on) {
+  if (on != s_led && s_edge_count < MAX_EDGES) {
+    s_edges[s_edge_count++] = mu_sched_get_current_time();
+  }
+  s_led = on;
+}
+
+// =============================================================================
+// private code
+
+static void setup(void) {
+  mu_sched_init();
+  mu_sim_init(START);
+  mu_task_init(&s_coro.task, coro_fn, &s_coro, "Coro");
+  MU_CORO_INIT(&s_coro.coro);
+  mu_task_init(&s_other_task, other_fn, NULL, "Other");
+  mu_task_init(&s_sub_task, sub_fn, NULL, "Sub");
+  mu_task_init(&s_done_task, done_fn, NULL, "Done");
+  s_point_count = 0;
+  s_edge_count = 0;
+  s_led = false;
+  s_done_at = 0;
+  s_done_count = 0;
+}
+
+static void coro_fn(void *ctx, void *arg) {
+  coro_ctx_t *self = (coro_ctx_t *)ctx;
+  (void)arg;
+
+  MU_CORO_BEGIN(&self->coro);
+  record(POINT_BEGIN);
+  MU_YIELD(&self->coro);
+  record(POINT_YIELD);
+  MU_AWAIT_FOR(&self->coro, AWAIT_FOR_DT);
+  record(POINT_AWAIT_FOR);
+  MU_AWAIT_UNTIL(&self->coro, AWAIT_UNTIL_AT);
+  record(POINT_AWAIT_UNTIL);
+  MU_AWAIT(&self->coro, &s_sub_task);
+  record(POINT_AWAIT);
+  MU_CORO_END(&self->coro);
+}
+
+static void other_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+  record(POINT_OTHER);
+}
+
+// A sub-task that completes SUB_DELAY after it starts, by the on_completion
+// convention MU_AWAIT relies on.
+static void sub_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+  record(POINT_SUB);
+  mu_sched_task_in(&s_coro.task, SUB_DELAY);
+}
+
+static void done_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+  s_done_at = mu_sched_get_current_time();
+  s_done_count += 1;
+}
+
+static void record(point_t point) {
+  if (s_point_count < MAX_POINTS) {
+    s_points[s_point_count] = point;
+    s_point_times[s_point_count] = mu_sched_get_current_time();
+    s_point_count += 1;
+  }
+}
+
+static bool edges_match(const int *quanta, int n_quanta) {
+  if (s_edge_count != n_quanta) {
+    return false;
+  }
+  for (int i = 0; i < n_quanta; i++) {
+    if (s_edges[i] != START + quanta[i] * QUANTUM) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,255 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_test_utils.h"
+#include "mu_cyclic/mu_cyclic.h"
+#include "core/mu_sched.h"
+#include <string.h>
+
+// =============================================================================
+// private types and definitions
+
+// The periods are in ticks.  The minor frame is their GCD and the major frame
+// their LCM: 10 and 1000 ticks, or 100 minor frames.
+#define SENSE_PERIOD 10
+#define CONTROL_PERIOD 50
+#define REPORT_PERIOD 1000
+
+#define N_FRAMES (REPORT_PERIOD / SENSE_PERIOD)
+
+// Virtual time to run the table for: two major frames.
+#define RUN_TIME (2 * REPORT_PERIOD)
+
+typedef enum { SENSE, CONTROL, REPORT, N_ENTRIES } entry_id_t;
+
+// =============================================================================
+// private declarations
+
+static void setup(void);
+
+static void run_until(mu_time_t end);
+
+static void entry_fn(void *ctx, void *arg);
+
+static mu_time_t get_time(void);
+
+// =============================================================================
+// local storage
+
+static int s_ids[N_ENTRIES] = {SENSE, CONTROL, REPORT};
+
+static const mu_cyclic_entry_t s_table[] = {
+    MU_CYCLIC_ENTRY("Sense", entry_fn, &s_ids[SENSE], SENSE_PERIOD),
+    MU_CYCLIC_ENTRY("Control", entry_fn, &s_ids[CONTROL], CONTROL_PERIOD),
+    MU_CYCLIC_ENTRY("Report", entry_fn, &s_ids[REPORT], REPORT_PERIOD),
+};
+
+// Periods of 20 and 30 ticks: a 10 tick minor frame with nothing due in some
+// frames.
+static const mu_cyclic_entry_t s_sparse_table[] = {
+    MU_CYCLIC_ENTRY("Twenty", entry_fn, &s_ids[SENSE], 20),
+    MU_CYCLIC_ENTRY("Thirty", entry_fn, &s_ids[CONTROL], 30),
+};
+
+static const mu_cyclic_entry_t s_bad_table[] = {
+    MU_CYCLIC_ENTRY("Ok", entry_fn, &s_ids[SENSE], 10),
+    MU_CYCLIC_ENTRY("Zero", entry_fn, &s_ids[CONTROL], 0),
+};
+
+static mu_cyclic_entry_t s_wide_table[MU_CYCLIC_MAX_ENTRIES + 1];
+
+static mu_cyclic_t s_cyclic;
+
+static uint32_t s_masks[N_FRAMES];
+
+static mu_time_t s_now;
+
+// calls to each entry, and the time of each entry's most recent call
+static int s_calls[N_ENTRIES];
+static mu_time_t s_called_at[N_ENTRIES];
+
+// ticks the clock advances during each call to entry_fn
+static mu_duration_t s_entry_cost;
+
+// =============================================================================
+// public code
+
+void mu_cyclic_test() {
+  // mu_cyclic_err_t mu_cyclic_init(mu_cyclic_t *cyclic,
+  //                                const mu_cyclic_entry_t *entries,
+  //                                size_t n_entries,
+  //                                uint32_t *masks,
+  //                                size_t n_masks);
+  setup();
+  ASSERT(mu_cyclic_init(&s_cyclic, s_table, N_ENTRIES, s_masks, N_FRAMES) ==
+         MU_CYCLIC_ERR_NONE);
+  ASSERT(mu_cyclic_minor_frame(&s_cyclic) == SENSE_PERIOD);
+  ASSERT(mu_cyclic_frame_count(&s_cyclic) == N_FRAMES);
+  ASSERT(mu_cyclic_overrun_count(&s_cyclic) == 0);
+  ASSERT(mu_cyclic_overrun_name(&s_cyclic) == NULL);
+  ASSERT(mu_sched_is_empty() == true);
+
+  // every entry is due in frame 0; SENSE in every frame; CONTROL every fifth
+  ASSERT(s_masks[0] == 0x7);
+  ASSERT(s_masks[1] == 0x1);
+  ASSERT(s_masks[4] == 0x1);
+  ASSERT(s_masks[5] == 0x3);
+  ASSERT(s_masks[50] == 0x3);
+  ASSERT(s_masks[N_FRAMES - 1] == 0x1);
+
+  // frames with nothing due get an empty mask
+  ASSERT(mu_cyclic_init(&s_cyclic, s_sparse_table, 2, s_masks, N_FRAMES) ==
+         MU_CYCLIC_ERR_NONE);
+  ASSERT(mu_cyclic_minor_frame(&s_cyclic) == 10);
+  ASSERT(mu_cyclic_frame_count(&s_cyclic) == 6);
+  ASSERT(s_masks[0] == 0x3);
+  ASSERT(s_masks[1] == 0x0);
+  ASSERT(s_masks[2] == 0x1);
+  ASSERT(s_masks[3] == 0x2);
+  ASSERT(s_masks[4] == 0x1);
+  ASSERT(s_masks[5] == 0x0);
+
+  // errors
+  ASSERT(mu_cyclic_init(&s_cyclic, s_table, 0, s_masks, N_FRAMES) ==
+         MU_CYCLIC_ERR_SIZE);
+  ASSERT(mu_cyclic_init(&s_cyclic, s_table, N_ENTRIES, s_masks, N_FRAMES - 1) ==
+         MU_CYCLIC_ERR_SIZE);
+  ASSERT(mu_cyclic_init(&s_cyclic, s_bad_table, 2, s_masks, N_FRAMES) ==
+         MU_CYCLIC_ERR_PERIOD);
+  for (int i = 0; i < MU_CYCLIC_MAX_ENTRIES + 1; i++) {
+    s_wide_table[i] = s_table[SENSE];
+  }
+  ASSERT(mu_cyclic_init(&s_cyclic, s_wide_table, MU_CYCLIC_MAX_ENTRIES,
+                        s_masks, N_FRAMES) == MU_CYCLIC_ERR_NONE);
+  ASSERT(s_masks[0] == 0xffffffff);
+  ASSERT(mu_cyclic_init(&s_cyclic, s_wide_table, MU_CYCLIC_MAX_ENTRIES + 1,
+                        s_masks, N_FRAMES) == MU_CYCLIC_ERR_SIZE);
+
+  // mu_sched_err_t mu_cyclic_start(mu_cyclic_t *cyclic, mu_time_t at);
+  // one task on the schedule, whatever the number of entries
+  setup();
+  mu_cyclic_init(&s_cyclic, s_table, N_ENTRIES, s_masks, N_FRAMES);
+  ASSERT(mu_cyclic_start(&s_cyclic, 5) == MU_SCHED_ERR_NONE);
+  ASSERT(mu_sched_task_count() == 1);
+  ASSERT(mu_sched_get_next_task() == mu_cyclic_task(&s_cyclic));
+  ASSERT(mu_task_get_time(mu_cyclic_task(&s_cyclic)) == 5);
+
+  // the first frame runs every entry, in table order, and schedules the next
+  // frame one minor frame after the first
+  run_until(6);
+  ASSERT(s_calls[SENSE] == 1);
+  ASSERT(s_calls[CONTROL] == 1);
+  ASSERT(s_calls[REPORT] == 1);
+  ASSERT(mu_sched_task_count() == 1);
+  ASSERT(mu_task_get_time(mu_cyclic_task(&s_cyclic)) == 15);
+
+  // each entry runs once per period, on time
+  run_until(5 + RUN_TIME);
+  ASSERT(s_calls[SENSE] == RUN_TIME / SENSE_PERIOD);
+  ASSERT(s_calls[CONTROL] == RUN_TIME / CONTROL_PERIOD);
+  ASSERT(s_calls[REPORT] == RUN_TIME / REPORT_PERIOD);
+  ASSERT(s_called_at[SENSE] == 5 + RUN_TIME - SENSE_PERIOD);
+  ASSERT(s_called_at[CONTROL] == 5 + RUN_TIME - CONTROL_PERIOD);
+  ASSERT(s_called_at[REPORT] == 5 + RUN_TIME - REPORT_PERIOD);
+  ASSERT(mu_cyclic_overrun_count(&s_cyclic) == 0);
+
+  // void mu_cyclic_stop(mu_cyclic_t *cyclic);
+  mu_cyclic_stop(&s_cyclic);
+  ASSERT(mu_sched_is_empty() == true);
+
+  // restarting starts over from the first frame
+  ASSERT(mu_cyclic_start(&s_cyclic, 3000) == MU_SCHED_ERR_NONE);
+  s_calls[REPORT] = 0;
+  run_until(3001);
+  ASSERT(s_calls[REPORT] == 1);
+  mu_cyclic_stop(&s_cyclic);
+
+  // unsigned long mu_cyclic_overrun_count(mu_cyclic_t *cyclic);
+  // const char *mu_cyclic_overrun_name(mu_cyclic_t *cyclic);
+  // Each entry call takes 4 ticks, so the first frame (3 entries) overruns
+  // the 10 tick minor frame and the next (1 entry) catches up.
+  setup();
+  mu_cyclic_init(&s_cyclic, s_table, N_ENTRIES, s_masks, N_FRAMES);
+  s_entry_cost = 4;
+  mu_cyclic_start(&s_cyclic, 0);
+  run_until(1);
+  ASSERT(mu_cyclic_overrun_count(&s_cyclic) == 1);
+  ASSERT(strcmp(mu_cyclic_overrun_name(&s_cyclic), "Report") == 0);
+  ASSERT(s_now == 12);
+  ASSERT(mu_task_get_time(mu_cyclic_task(&s_cyclic)) == 10);
+
+  // the late frame runs rather than being skipped, and the frame after it
+  // is back on the 10 tick grid
+  run_until(13);
+  ASSERT(s_calls[SENSE] == 2);
+  ASSERT(s_called_at[SENSE] == 12);
+  ASSERT(mu_cyclic_overrun_count(&s_cyclic) == 1);
+  ASSERT(mu_task_get_time(mu_cyclic_task(&s_cyclic)) == 20);
+
+  mu_sched_reset();
+}
+
+// =============================================================================
+// private code
+
+static void setup(void) {
+  mu_sched_init();
+  s_now = 0;
+  mu_sched_set_clock_source(get_time);
+  for (int i = 0; i < N_ENTRIES; i++) {
+    s_calls[i] = 0;
+    s_called_at[i] = 0;
+  }
+  s_entry_cost = 0;
+}
+
+// Run every frame due before `end`, advancing the clock to each frame's start
+// unless an overrun has already carried it past.
+static void run_until(mu_time_t end) {
+  while (!mu_sched_is_empty()) {
+    mu_time_t at = mu_task_get_time(mu_sched_get_next_task());
+    if (!mu_time_precedes(at, end)) {
+      break;
+    }
+    if (mu_time_precedes(s_now, at)) {
+      s_now = at;
+    }
+    mu_sched_step();
+  }
+}
+
+static void entry_fn(void *ctx, void *arg) {
+  int id = *(int *)ctx;
+  (void)arg;
+  s_calls[id] += 1;
+  s_called_at[id] = s_now;
+  s_now = mu_time_offset(s_now, s_entry_cost);
+}
+
+static mu_time_t get_time(void) {
+  return s_now;
+}
@@ -0,0 +1,209 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_test_utils.h"
+#include "mu_hist/mu_hist.h"
+#include <stdint.h>
+#include <string.h>
+
+// =============================================================================
+// private types and definitions
+
+// header, count and max, then one count per bucket
+#define BINARY_SIZE (4 + 4 + 4 + 4 * MU_HIST_BUCKETS)
+
+// =============================================================================
+// private declarations
+
+static void putc_fn(char ch);
+
+static void write_fn(const uint8_t *buf, size_t n);
+
+static uint32_t get_uint32(const uint8_t *buf);
+
+// =============================================================================
+// local storage
+
+static uint32_t s_counts[MU_HIST_BUCKETS];
+static mu_hist_t s_hist;
+
+static char s_text[200];
+static size_t s_text_len;
+
+static uint8_t s_binary[BINARY_SIZE + 4];
+static size_t s_binary_len;
+
+// =============================================================================
+// public code
+
+void mu_hist_test() {
+  // 2 sub-bits: one bucket per value below 4, then 4 per power of two
+  ASSERT(MU_HIST_BUCKETS == 124);
+
+  // size_t mu_hist_bucket_index(uint32_t value);
+  // values below 8 are exact
+  for (uint32_t v = 0; v < 8; v++) {
+    ASSERT(mu_hist_bucket_index(v) == v);
+  }
+  // 8..15 split into pairs, 16..31 into fours
+  ASSERT(mu_hist_bucket_index(8) == 8);
+  ASSERT(mu_hist_bucket_index(9) == 8);
+  ASSERT(mu_hist_bucket_index(10) == 9);
+  ASSERT(mu_hist_bucket_index(15) == 11);
+  ASSERT(mu_hist_bucket_index(16) == 12);
+  ASSERT(mu_hist_bucket_index(19) == 12);
+  ASSERT(mu_hist_bucket_index(20) == 13);
+  ASSERT(mu_hist_bucket_index(31) == 15);
+  ASSERT(mu_hist_bucket_index(0x80000000) == MU_HIST_BUCKETS - 4);
+  ASSERT(mu_hist_bucket_index(UINT32_MAX) == MU_HIST_BUCKETS - 1);
+
+  // uint32_t mu_hist_bucket_lower(size_t index);
+  // uint32_t mu_hist_bucket_upper(size_t index);
+  ASSERT(mu_hist_bucket_lower(0) == 0);
+  ASSERT(mu_hist_bucket_upper(0) == 0);
+  ASSERT(mu_hist_bucket_lower(7) == 7);
+  ASSERT(mu_hist_bucket_upper(7) == 7);
+  ASSERT(mu_hist_bucket_lower(8) == 8);
+  ASSERT(mu_hist_bucket_upper(8) == 9);
+  ASSERT(mu_hist_bucket_lower(13) == 20);
+  ASSERT(mu_hist_bucket_upper(13) == 23);
+  ASSERT(mu_hist_bucket_lower(MU_HIST_BUCKETS - 1) == 0xe0000000);
+  ASSERT(mu_hist_bucket_upper(MU_HIST_BUCKETS - 1) == UINT32_MAX);
+
+  // the buckets tile 0..UINT32_MAX with no gaps or overlaps, each bucket's
+  // bounds fall in that bucket, and no bucket is wider than a quarter of its
+  // lower bound
+  for (size_t i = 0; i < MU_HIST_BUCKETS; i++) {
+    uint32_t lower = mu_hist_bucket_lower(i);
+    uint32_t upper = mu_hist_bucket_upper(i);
+    ASSERT(mu_hist_bucket_index(lower) == i);
+    ASSERT(mu_hist_bucket_index(upper) == i);
+    ASSERT(upper - lower <= lower / 4);
+    if (i + 1 < MU_HIST_BUCKETS) {
+      ASSERT(mu_hist_bucket_lower(i + 1) == upper + 1);
+    }
+  }
+
+  // mu_hist_t *mu_hist_init(mu_hist_t *hist, uint32_t *counts);
+  memset(s_counts, 0xff, sizeof(s_counts));
+  ASSERT(mu_hist_init(&s_hist, s_counts) == &s_hist);
+  ASSERT(mu_hist_count(&s_hist) == 0);
+  ASSERT(mu_hist_max(&s_hist) == 0);
+  ASSERT(s_counts[0] == 0);
+  ASSERT(s_counts[MU_HIST_BUCKETS - 1] == 0);
+  ASSERT(mu_hist_percentile(&s_hist, 500) == 0);
+
+  // uint32_t mu_hist_percentile(const mu_hist_t *hist, uint32_t permille);
+  // 989 values of 10, ten of 100 (ranks 990 to 999) and one of 5000
+  for (int i = 0; i < 989; i++) {
+    mu_hist_record(&s_hist, 10);
+  }
+  for (int i = 0; i < 10; i++) {
+    mu_hist_record(&s_hist, 100);
+  }
+  mu_hist_record(&s_hist, 5000);
+  ASSERT(mu_hist_count(&s_hist) == 1000);
+  ASSERT(mu_hist_max(&s_hist) == 5000);
+
+  // each percentile is the upper bound of its value's bucket: 10 is in
+  // [10, 11] and 100 in [96, 111]
+  ASSERT(mu_hist_percentile(&s_hist, 0) == 11);
+  ASSERT(mu_hist_percentile(&s_hist, 500) == 11);
+  ASSERT(mu_hist_percentile(&s_hist, 989) == 11);
+  ASSERT(mu_hist_percentile(&s_hist, 990) == 111);
+  ASSERT(mu_hist_percentile(&s_hist, 999) == 111);
+  // the top bucket, [4608, 5119], is clamped to the largest value seen
+  ASSERT(mu_hist_percentile(&s_hist, 1000) == 5000);
+  ASSERT(mu_hist_percentile(&s_hist, 2000) == 5000);
+
+  // ranks round up: with 3 values, p50 is the 2nd
+  mu_hist_reset(&s_hist);
+  ASSERT(mu_hist_count(&s_hist) == 0);
+  ASSERT(mu_hist_max(&s_hist) == 0);
+  mu_hist_record(&s_hist, 1);
+  mu_hist_record(&s_hist, 2);
+  mu_hist_record(&s_hist, 3);
+  ASSERT(mu_hist_percentile(&s_hist, 500) == 2);
+  ASSERT(mu_hist_percentile(&s_hist, 333) == 1);
+  ASSERT(mu_hist_percentile(&s_hist, 334) == 2);
+  ASSERT(mu_hist_percentile(&s_hist, 999) == 3);
+
+  // counts saturate rather than wrap
+  s_counts[1] = UINT32_MAX;
+  mu_hist_record(&s_hist, 1);
+  ASSERT(s_counts[1] == UINT32_MAX);
+  s_hist.total = UINT32_MAX;
+  mu_hist_record(&s_hist, 2);
+  ASSERT(mu_hist_count(&s_hist) == UINT32_MAX);
+
+  // void mu_hist_dump_text(const mu_hist_t *hist, mu_hist_putc_fn putc_fn);
+  mu_hist_reset(&s_hist);
+  mu_hist_record(&s_hist, 3);
+  mu_hist_record(&s_hist, 100);
+  mu_hist_record(&s_hist, 100);
+  mu_hist_record(&s_hist, UINT32_MAX);
+  s_text_len = 0;
+  mu_hist_dump_text(&s_hist, putc_fn);
+  s_text[s_text_len] = '\0';
+  ASSERT(strcmp(s_text, "3 1\n111 2\n4294967295 1\n") == 0);
+
+  // void mu_hist_dump_binary(const mu_hist_t *hist,
+  //                          mu_hist_write_fn write_fn);
+  s_binary_len = 0;
+  mu_hist_dump_binary(&s_hist, write_fn);
+  ASSERT(s_binary_len == BINARY_SIZE);
+  ASSERT(s_binary[0] == MU_HIST_BINARY_VERSION);
+  ASSERT(s_binary[1] == MU_HIST_SUB_BITS);
+  ASSERT(s_binary[2] == MU_HIST_BUCKETS);
+  ASSERT(s_binary[3] == 0);
+  ASSERT(get_uint32(&s_binary[4]) == 4);
+  ASSERT(get_uint32(&s_binary[8]) == UINT32_MAX);
+  ASSERT(get_uint32(&s_binary[12 + 4 * 3]) == 1);
+  ASSERT(get_uint32(&s_binary[12 + 4 * mu_hist_bucket_index(100)]) == 2);
+  ASSERT(get_uint32(&s_binary[12 + 4 * (MU_HIST_BUCKETS - 1)]) == 1);
+  ASSERT(get_uint32(&s_binary[12 + 4 * 4]) == 0);
+}
+
+// =============================================================================
+// private code
+
+static void putc_fn(char ch) {
+  if (s_text_len < sizeof(s_text) - 1) {
+    s_text[s_text_len++] = ch;
+  }
+}
+
+static void write_fn(const uint8_t *buf, size_t n) {
+  for (size_t i = 0; i < n && s_binary_len < sizeof(s_binary); i++) {
+    s_binary[s_binary_len++] = buf[i];
+  }
+}
+
+static uint32_t get_uint32(const uint8_t *buf) {
+  return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+         ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
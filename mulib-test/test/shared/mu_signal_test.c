@@ -0,0 +1,142 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_test_utils.h"
+#include "mu_signal/mu_signal.h"
+#include "core/mu_sched.h"
+
+// =============================================================================
+// private types and definitions
+
+// =============================================================================
+// private declarations
+
+static void setup(void);
+
+static void target_fn(void *ctx, void *arg);
+
+static mu_time_t get_time(void);
+
+// =============================================================================
+// local storage
+
+static mu_signal_t s_signal;
+
+static mu_task_t s_target;
+
+// number of times target_fn ran, and what it took on its last run
+static int s_call_count;
+static uint32_t s_taken;
+
+// =============================================================================
+// public code
+
+void mu_signal_test() {
+  // mu_signal_t *mu_signal_init(mu_signal_t *sig, mu_task_t *target);
+  setup();
+  ASSERT(mu_signal_count(&s_signal) == 0);
+  ASSERT(mu_sched_is_empty() == true);
+  ASSERT(mu_signal_take(&s_signal) == 0);
+
+  // void mu_signal_post(mu_signal_t *sig);
+  // the first post schedules the target
+  mu_signal_post(&s_signal);
+  ASSERT(mu_signal_count(&s_signal) == 1);
+  ASSERT(mu_sched_task_count() == 1);
+  ASSERT(mu_sched_get_next_task() == &s_target);
+
+  // later posts only add to the count
+  mu_signal_post(&s_signal);
+  mu_signal_post(&s_signal);
+  ASSERT(mu_signal_count(&s_signal) == 3);
+  ASSERT(mu_sched_task_count() == 1);
+
+  // uint32_t mu_signal_take(mu_signal_t *sig);
+  // one dispatch answers all three posts
+  ASSERT(mu_sched_step() == MU_SCHED_ERR_NONE);
+  ASSERT(s_call_count == 1);
+  ASSERT(s_taken == 3);
+  ASSERT(mu_signal_count(&s_signal) == 0);
+  ASSERT(mu_sched_is_empty() == true);
+  ASSERT(mu_sched_step() == MU_SCHED_ERR_NONE);
+  ASSERT(s_call_count == 1);
+
+  // a post after the take schedules the target again
+  mu_signal_post(&s_signal);
+  ASSERT(mu_sched_task_count() == 1);
+  ASSERT(mu_sched_step() == MU_SCHED_ERR_NONE);
+  ASSERT(s_call_count == 2);
+  ASSERT(s_taken == 1);
+
+  // void mu_signal_isr_post(mu_signal_t *sig);
+  // a burst of interrupts takes one ISR queue entry and one dispatch
+  setup();
+  mu_signal_isr_post(&s_signal);
+  mu_signal_isr_post(&s_signal);
+  mu_signal_isr_post(&s_signal);
+  mu_signal_isr_post(&s_signal);
+  ASSERT(mu_signal_count(&s_signal) == 4);
+  ASSERT(mu_sched_step() == MU_SCHED_ERR_NONE);
+  ASSERT(s_call_count == 1);
+  ASSERT(s_taken == 4);
+  ASSERT(mu_sched_is_empty() == true);
+
+  // task and ISR posts share the count
+  setup();
+  mu_signal_post(&s_signal);
+  mu_signal_isr_post(&s_signal);
+  ASSERT(mu_signal_count(&s_signal) == 2);
+  ASSERT(mu_sched_step() == MU_SCHED_ERR_NONE);
+  ASSERT(s_call_count == 1);
+  ASSERT(s_taken == 2);
+  ASSERT(mu_sched_is_empty() == true);
+
+  mu_sched_reset();
+}
+
+// =============================================================================
+// private code
+
+static void setup(void) {
+  mu_sched_init();
+  mu_sched_set_clock_source(get_time);
+  mu_task_init(&s_target, target_fn, NULL, "Signal Target");
+  mu_signal_init(&s_signal, &s_target);
+  s_call_count = 0;
+  s_taken = 0;
+}
+
+static void target_fn(void *ctx, void *arg) {
+  (void)ctx;
+  (void)arg;
+  s_call_count += 1;
+  s_taken = mu_signal_take(&s_signal);
+}
+
+static mu_time_t get_time(void) {
+  return 0;
+}
@@ -0,0 +1,334 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * mu_trace_to_json: convert a dumped mu_sched trace ring into Chrome / Perfetto
+ * trace-event JSON.
+ *
+ * Usage:
+ *
+ *   mu_trace_to_json trace.bin > trace.json
+ *
+ * then open trace.json in https://ui.perfetto.dev or chrome://tracing.
+ *
+ * To compile (into ../build) and run the round-trip test:
+ *
+ *   make trace_test
+ *
+ * The dump format is described below.  All multi-byte fields are
+ * little-endian, regardless of the target that wrote them.
+ *
+ *   header (28 bytes):
+ *     char     magic[4]       "MUTR"
+ *     uint8    version        MU_TRACE_VERSION
+ *     uint8    time_size      bytes per mu_time_t: 4, or 8 on the host port.
+ *                             0 (from a version 1 writer) means 4.
+ *     uint16   record_size    4 + 3 * time_size + 4
+ *     uint32   ticks_per_sec  mu_time_t ticks per second on the target
+ *     uint32   capacity       number of records in the ring
+ *     uint32   head           index of the next record to be written
+ *     uint32   count          total records ever written (saturating)
+ *     uint32   n_names        number of entries in the name table
+ *
+ *   records (capacity * record_size bytes), oldest at head if the ring has
+ *   wrapped (count >= capacity), otherwise at index 0:
+ *     uint32   task           task address (low 32 bits)
+ *     time     scheduled      time the task was due
+ *     time     start          time mu_sched_step() called it
+ *     time     end            time it returned
+ *     uint8    origin         MU_TRACE_ORIGIN_xxx
+ *     uint8    reserved[3]
+ *
+ *   where each time is a time_size byte mu_time_t.  32-bit times wrap (every
+ *   4.3 s for nanoseconds), so they are unwrapped on the assumption that
+ *   successive records start less than half the time range apart.  64-bit
+ *   times are used as they are.
+ *
+ *   name table (n_names entries):
+ *     uint32   task           task address (low 32 bits)
+ *     uint8    length
+ *     char     name[length]   not NUL terminated
+ */
+
+// =============================================================================
+// includes
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// private types and definitions
+
+#define MU_TRACE_VERSION 1
+#define MU_TRACE_HEADER_SIZE 28
+
+// record size for a given time_size
+#define MU_TRACE_RECORD_SIZE(time_size) (4 + 3 * (time_size) + 4)
+
+#define MU_TRACE_ORIGIN_TIMED 0  // queued with mu_sched_task_at() and friends
+#define MU_TRACE_ORIGIN_ISR 1    // posted with mu_sched_isr_task_now()
+#define MU_TRACE_ORIGIN_IDLE 2   // the idle task
+
+#define MAX_NAME_LENGTH 255
+
+typedef struct {
+  uint32_t task;
+  uint64_t scheduled;
+  uint64_t start;
+  uint64_t end;
+  uint8_t origin;
+} trace_record_t;
+
+typedef struct {
+  uint32_t task;
+  char name[MAX_NAME_LENGTH + 1];
+} trace_name_t;
+
+// =============================================================================
+// private declarations
+
+static bool read_bytes(FILE *f, uint8_t *buf, size_t n);
+
+static uint16_t get_u16(const uint8_t *p);
+
+static uint32_t get_u32(const uint8_t *p);
+
+static uint64_t get_time(const uint8_t *p, unsigned int time_size);
+
+static int64_t time_difference(uint64_t t1,
+                               uint64_t t2,
+                               unsigned int time_size);
+
+static const char *task_name(uint32_t task, char *buf, size_t size);
+
+static const char *origin_name(uint8_t origin);
+
+static void print_json_string(const char *s);
+
+static int fail(const char *msg);
+
+// =============================================================================
+// local storage
+
+static trace_name_t *s_names;
+
+static uint32_t s_n_names;
+
+// =============================================================================
+// public code
+
+int main(int argc, char *argv[]) {
+  uint8_t header[MU_TRACE_HEADER_SIZE];
+  uint8_t *raw;
+  FILE *f;
+  uint32_t ticks_per_sec, capacity, head, count, n_records, first;
+  unsigned int time_size, record_size;
+  int64_t base = 0;   // start of the current record, relative to the oldest
+  uint64_t prev = 0;  // raw start of the previous record
+  bool have_prev = false;
+  char buf[32];
+
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <trace.bin>\n", argv[0]);
+    return 1;
+  }
+  if ((f = fopen(argv[1], "rb")) == NULL) {
+    return fail("can't open trace file");
+  }
+
+  // header
+  if (!read_bytes(f, header, sizeof(header)) ||
+      memcmp(header, "MUTR", 4) != 0) {
+    return fail("not a mu_sched trace file");
+  }
+  time_size = (header[5] == 0) ? 4 : header[5];
+  record_size = get_u16(&header[6]);
+  if (header[4] != MU_TRACE_VERSION || (time_size != 4 && time_size != 8) ||
+      record_size != MU_TRACE_RECORD_SIZE(time_size)) {
+    return fail("unsupported trace version, time size or record size");
+  }
+  ticks_per_sec = get_u32(&header[8]);
+  capacity = get_u32(&header[12]);
+  head = get_u32(&header[16]);
+  count = get_u32(&header[20]);
+  s_n_names = get_u32(&header[24]);
+  if (ticks_per_sec == 0 || (capacity > 0 && head >= capacity)) {
+    return fail("corrupt trace header");
+  }
+
+  // records
+  if ((raw = malloc((size_t)capacity * record_size + 1)) == NULL) {
+    return fail("out of memory");
+  }
+  if (!read_bytes(f, raw, (size_t)capacity * record_size)) {
+    return fail("truncated trace records");
+  }
+
+  // name table
+  if ((s_names = calloc(s_n_names + 1, sizeof(trace_name_t))) == NULL) {
+    return fail("out of memory");
+  }
+  for (uint32_t i = 0; i < s_n_names; i++) {
+    uint8_t entry[5];
+    if (!read_bytes(f, entry, sizeof(entry)) ||
+        !read_bytes(f, (uint8_t *)s_names[i].name, entry[4])) {
+      return fail("truncated name table");
+    }
+    s_names[i].task = get_u32(entry);
+    s_names[i].name[entry[4]] = '\0';
+  }
+  fclose(f);
+
+  // oldest record first
+  if (count >= capacity) {
+    n_records = capacity;
+    first = head;
+  } else {
+    n_records = count;
+    first = 0;
+  }
+
+  printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  printf("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+         "\"args\":{\"name\":\"mu_sched\"}}");
+  for (uint32_t i = 0; i < n_records; i++) {
+    const uint8_t *p = &raw[((first + i) % capacity) * record_size];
+    trace_record_t r;
+    double ts_us, dur_us, late_us;
+
+    r.task = get_u32(&p[0]);
+    r.scheduled = get_time(&p[4], time_size);
+    r.start = get_time(&p[4 + time_size], time_size);
+    r.end = get_time(&p[4 + 2 * time_size], time_size);
+    r.origin = p[4 + 3 * time_size];
+
+    // lay start times out on a 64-bit timeline that begins at the oldest
+    // record.  time_difference() unwraps 32-bit times.
+    if (!have_prev) {
+      base = 0;
+      have_prev = true;
+    } else {
+      base += time_difference(r.start, prev, time_size);
+    }
+    prev = r.start;
+
+    ts_us = (double)base * 1e6 / ticks_per_sec;
+    dur_us = (double)time_difference(r.end, r.start, time_size) * 1e6 /
+             ticks_per_sec;
+    late_us = (double)time_difference(r.start, r.scheduled, time_size) * 1e6 /
+              ticks_per_sec;
+
+    printf(",\n{\"name\":");
+    print_json_string(task_name(r.task, buf, sizeof(buf)));
+    printf(",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+           "\"ts\":%.3f,\"dur\":%.3f,"
+           "\"args\":{\"task\":\"0x%08" PRIx32 "\",\"late_us\":%.3f}}",
+           origin_name(r.origin), ts_us, dur_us, r.task, late_us);
+  }
+  printf("\n]}\n");
+
+  free(raw);
+  free(s_names);
+  return 0;
+}
+
+// =============================================================================
+// private code
+
+static bool read_bytes(FILE *f, uint8_t *buf, size_t n) {
+  return fread(buf, 1, n, f) == n;
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_time(const uint8_t *p, unsigned int time_size) {
+  if (time_size == 4) {
+    return get_u32(p);
+  }
+  return (uint64_t)get_u32(p) | ((uint64_t)get_u32(&p[4]) << 32);
+}
+
+// t1 - t2, as a signed difference in the target's mu_time_t width
+static int64_t time_difference(uint64_t t1,
+                               uint64_t t2,
+                               unsigned int time_size) {
+  if (time_size == 4) {
+    return (int32_t)(uint32_t)(t1 - t2);
+  }
+  return (int64_t)(t1 - t2);
+}
+
+static const char *task_name(uint32_t task, char *buf, size_t size) {
+  for (uint32_t i = 0; i < s_n_names; i++) {
+    if (s_names[i].task == task) {
+      return s_names[i].name;
+    }
+  }
+  snprintf(buf, size, "task 0x%08" PRIx32, task);
+  return buf;
+}
+
+static const char *origin_name(uint8_t origin) {
+  switch (origin) {
+  case MU_TRACE_ORIGIN_TIMED:
+    return "timed";
+  case MU_TRACE_ORIGIN_ISR:
+    return "isr";
+  case MU_TRACE_ORIGIN_IDLE:
+    return "idle";
+  default:
+    return "unknown";
+  }
+}
+
+static void print_json_string(const char *s) {
+  putchar('"');
+  for (; *s != '\0'; s++) {
+    unsigned char c = (unsigned char)*s;
+    if (c == '"' || c == '\\') {
+      printf("\\%c", c);
+    } else if (c < 0x20) {
+      printf("\\u%04x", c);
+    } else {
+      putchar(c);
+    }
+  }
+  putchar('"');
+}
+
+static int fail(const char *msg) {
+  fprintf(stderr, "mu_trace_to_json: %s\n", msg);
+  return 1;
+}
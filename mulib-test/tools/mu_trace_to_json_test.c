@@ -0,0 +1,261 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2021 R. Dunbar Poor <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * Round-trip test for mu_trace_to_json: write trace dumps with known records,
+ * convert them, and check the "ts" and "dur" of each event in the JSON.
+ *
+ * Usage (run by `make trace_test`):
+ *
+ *   mu_trace_to_json_test ../build/mu_trace_to_json
+ */
+
+// =============================================================================
+// includes
+
+#include "mu_test_utils.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// private types and definitions
+
+#define TRACE_FILE "mu_trace_to_json_test.bin"
+
+#define MAX_RECORDS 8
+
+#define MAX_LINE 512
+
+typedef struct {
+  uint32_t task;
+  uint64_t scheduled;
+  uint64_t start;
+  uint64_t end;
+} test_record_t;
+
+typedef struct {
+  double ts;
+  double dur;
+} test_event_t;
+
+// =============================================================================
+// private declarations
+
+static bool write_trace(uint8_t time_size,
+                        uint32_t ticks_per_sec,
+                        uint32_t head,
+                        uint32_t count,
+                        const test_record_t *records,
+                        size_t capacity);
+
+static void put_u16(FILE *f, uint16_t v);
+
+static void put_u32(FILE *f, uint32_t v);
+
+static void put_time(FILE *f, uint64_t v, uint8_t time_size);
+
+static int convert(const char *tool, test_event_t *events, int max_events);
+
+static bool near(double a, double b);
+
+static void test_host_64_bit(const char *tool);
+
+static void test_wrapped_32_bit(const char *tool);
+
+static void test_wrapped_ring(const char *tool);
+
+// =============================================================================
+// public code
+
+int main(int argc, char *argv[]) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <path to mu_trace_to_json>\n", argv[0]);
+    return 1;
+  }
+
+  mu_test_init();
+  printf("\r\nstarting mu_trace_to_json_test...");
+
+  test_host_64_bit(argv[1]);
+  test_wrapped_32_bit(argv[1]);
+  test_wrapped_ring(argv[1]);
+
+  remove(TRACE_FILE);
+
+  printf("ending mu_trace_to_json_test: %d error%s out of %d test%s\r\n",
+         mu_test_error_count(),
+         mu_test_error_count() == 1 ? "" : "s",
+         mu_test_count(),
+         mu_test_count() == 1 ? "" : "s");
+
+  return mu_test_error_count();  // return error code 0 on success
+}
+
+// =============================================================================
+// private code
+
+// The host port: 64-bit nanosecond times, with records further apart than a
+// 32-bit nanosecond count can span.
+static void test_host_64_bit(const char *tool) {
+  const uint64_t t0 = 5000000000ULL;  // past 2^32 ns
+  test_record_t records[] = {
+      {0x1000, t0, t0, t0 + 2000},
+      {0x2000, t0 + 3000000000ULL, t0 + 3000001000ULL, t0 + 3000004000ULL},
+      {0x1000, t0 + 10000000000ULL, t0 + 10000000000ULL, t0 + 10000500000ULL},
+  };
+  test_event_t events[MAX_RECORDS];
+
+  ASSERT(write_trace(8, 1000000000, 3, 3, records, 3) == true);
+  ASSERT(convert(tool, events, MAX_RECORDS) == 3);
+  ASSERT(near(events[0].ts, 0.0));
+  ASSERT(near(events[0].dur, 2.0));
+  ASSERT(near(events[1].ts, 3000001.0));
+  ASSERT(near(events[1].dur, 3.0));
+  ASSERT(near(events[2].ts, 10000000.0));
+  ASSERT(near(events[2].dur, 500.0));
+}
+
+// A 32-bit port: times that wrap between records, and within a record.
+static void test_wrapped_32_bit(const char *tool) {
+  test_record_t records[] = {
+      {0x1000, 0xfffffe00, 0xffffff00, 0xffffff80},
+      {0x2000, 0xffffff80, 0xffffffc0, 0x00000040},
+      {0x1000, 0x00000100, 0x00000100, 0x00000200},
+  };
+  test_event_t events[MAX_RECORDS];
+
+  ASSERT(write_trace(4, 1000000, 3, 3, records, 3) == true);
+  ASSERT(convert(tool, events, MAX_RECORDS) == 3);
+  ASSERT(near(events[0].ts, 0.0));
+  ASSERT(near(events[0].dur, 128.0));
+  ASSERT(near(events[1].ts, 192.0));
+  ASSERT(near(events[1].dur, 128.0));
+  ASSERT(near(events[2].ts, 512.0));
+  ASSERT(near(events[2].dur, 256.0));
+}
+
+// A ring that has wrapped: the oldest record is at head.
+static void test_wrapped_ring(const char *tool) {
+  test_record_t records[] = {
+      {0x3000, 400, 400, 410},
+      {0x1000, 200, 200, 220},
+      {0x2000, 300, 300, 330},
+  };
+  test_event_t events[MAX_RECORDS];
+
+  ASSERT(write_trace(8, 1000000, 1, 7, records, 3) == true);
+  ASSERT(convert(tool, events, MAX_RECORDS) == 3);
+  ASSERT(near(events[0].ts, 0.0));
+  ASSERT(near(events[0].dur, 20.0));
+  ASSERT(near(events[1].ts, 100.0));
+  ASSERT(near(events[1].dur, 30.0));
+  ASSERT(near(events[2].ts, 200.0));
+  ASSERT(near(events[2].dur, 10.0));
+}
+
+static bool write_trace(uint8_t time_size,
+                        uint32_t ticks_per_sec,
+                        uint32_t head,
+                        uint32_t count,
+                        const test_record_t *records,
+                        size_t capacity) {
+  FILE *f = fopen(TRACE_FILE, "wb");
+
+  if (f == NULL) {
+    return false;
+  }
+  fwrite("MUTR", 1, 4, f);
+  fputc(1, f);  // version
+  fputc(time_size, f);
+  put_u16(f, 4 + 3 * time_size + 4);
+  put_u32(f, ticks_per_sec);
+  put_u32(f, capacity);
+  put_u32(f, head % capacity);
+  put_u32(f, count);
+  put_u32(f, 1);  // n_names
+
+  for (size_t i = 0; i < capacity; i++) {
+    put_u32(f, records[i].task);
+    put_time(f, records[i].scheduled, time_size);
+    put_time(f, records[i].start, time_size);
+    put_time(f, records[i].end, time_size);
+    fputc(0, f);  // origin: timed
+    fputc(0, f);
+    fputc(0, f);
+    fputc(0, f);
+  }
+
+  put_u32(f, 0x1000);
+  fputc(5, f);
+  fwrite("blink", 1, 5, f);
+
+  return fclose(f) == 0;
+}
+
+static void put_u16(FILE *f, uint16_t v) {
+  fputc(v & 0xff, f);
+  fputc(v >> 8, f);
+}
+
+static void put_u32(FILE *f, uint32_t v) {
+  put_u16(f, v & 0xffff);
+  put_u16(f, v >> 16);
+}
+
+static void put_time(FILE *f, uint64_t v, uint8_t time_size) {
+  put_u32(f, (uint32_t)v);
+  if (time_size == 8) {
+    put_u32(f, (uint32_t)(v >> 32));
+  }
+}
+
+// Run the converter on TRACE_FILE and collect the "X" events.  Returns the
+// number of events, or -1 if the converter failed.
+static int convert(const char *tool, test_event_t *events, int max_events) {
+  char line[MAX_LINE];
+  FILE *p;
+  int n = 0;
+
+  snprintf(line, sizeof(line), "%s %s", tool, TRACE_FILE);
+  if ((p = popen(line, "r")) == NULL) {
+    return -1;
+  }
+  while (fgets(line, sizeof(line), p) != NULL) {
+    char *ts = strstr(line, "\"ts\":");
+    char *dur = strstr(line, "\"dur\":");
+    if (ts != NULL && dur != NULL && n < max_events) {
+      events[n].ts = strtod(ts + 5, NULL);
+      events[n].dur = strtod(dur + 6, NULL);
+      n += 1;
+    }
+  }
+  return (pclose(p) == 0) ? n : -1;
+}
+
+static bool near(double a, double b) {
+  return (a - b < 0.001) && (b - a < 0.001);
+}